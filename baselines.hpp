@@ -0,0 +1,520 @@
+// === VGC 2.5 PPE Baseline Heaps (malloc, Refcounting, shared_ptr, Mark-Sweep) ===
+// The zone workloads' allocation patterns on conventional memory management.
+
+#pragma once
+
+#include "measure.hpp"
+#include "zone.hpp"
+#include "zone_workloads.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace baseline {
+    using vgc::Object;
+    using vgc::kSlotBytes;
+    using vgc::term;
+
+    // Every baseline keeps the zone drivers' shape: the same sizes, the same
+    // ring and batch lengths, the same graph links, and every object read
+    // exactly once, so each checksum equals loop_chunk(0, N). Where the
+    // zone finds a graph node by address arithmetic, a baseline looks it up
+    // in a GraphTable.
+    constexpr std::size_t kBatch = 256;
+    constexpr std::size_t kShort = 64, kLong = 4096;
+
+    // ============================================================
+    // malloc/free: runs the zone drivers unchanged. Long-lived nodes are
+    // freed one by one, since there is no reset.
+    // ============================================================
+    struct MallocHeap {
+        static constexpr bool kBulkFree = false;
+        void* alloc(std::size_t bytes) { return std::malloc(bytes); }
+        void free(void* p, std::size_t) { std::free(p); }
+        void reset() {}
+    };
+
+    // ============================================================
+    // Intrusive atomic refcounting, CPython style: the count lives in the
+    // object, a store into a container or field is an incref, and dropping
+    // the local handle is a decref. The last decref frees the object.
+    // ============================================================
+    struct RcObject {
+        std::atomic<std::uint32_t> rc;
+        std::uint32_t bytes;
+        short value;
+    };
+
+    inline RcObject* rc_new(std::size_t bytes, std::size_t i) {
+        RcObject* o = static_cast<RcObject*>(std::malloc(bytes < sizeof(RcObject) ? sizeof(RcObject) : bytes));
+        if (!o) return nullptr;
+        new (&o->rc) std::atomic<std::uint32_t>(1);
+        o->bytes = static_cast<std::uint32_t>(bytes);
+        o->value = term(i);
+        return o;
+    }
+    inline void rc_incref(RcObject* o) { o->rc.fetch_add(1, std::memory_order_relaxed); }
+    inline void rc_decref(RcObject* o) {
+        if (o->rc.fetch_sub(1, std::memory_order_acq_rel) == 1) std::free(o);
+    }
+
+    // Store into a container slot: incref for the slot, decref for the handle.
+    inline void rc_store(RcObject*& slot, RcObject* o) {
+        rc_incref(o);
+        slot = o;
+        rc_decref(o);
+    }
+
+    inline short rc_small_churn(std::size_t n) {
+        RcObject* batch[kBatch];
+        short acc = 0;
+        std::size_t i = 0;
+        while (i < n) {
+            std::size_t k = 0;
+            for (; k < kBatch && i < n; ++k, ++i) {
+                RcObject* o = rc_new(kSlotBytes * (1 + (i & 3)), i);
+                if (!o) return acc;
+                rc_store(batch[k], o);
+            }
+            for (std::size_t j = 0; j < k; ++j) {
+                acc += batch[j]->value;
+                rc_decref(batch[j]);
+            }
+        }
+        return acc;
+    }
+
+    inline short rc_mixed_lifetime(std::size_t n) {
+        RcObject* short_ring[kShort] = {};
+        RcObject* long_ring[kLong] = {};
+        short acc = 0;
+        std::uint64_t rng = 0x9E3779B97F4A7C15ull;
+        std::size_t s = 0, l = 0;
+        auto place = [&](RcObject*& slot, RcObject* o) {
+            if (slot) {
+                acc += slot->value;
+                rc_decref(slot);
+                slot = nullptr;
+            }
+            if (o) rc_store(slot, o);
+        };
+        for (std::size_t i = 0; i < n; ++i) {
+            RcObject* o = rc_new(vgc::object_bytes(rng, 256), i);
+            if (!o) return acc;
+            if (i % 8 == 0) place(long_ring[l++ % kLong], o);
+            else place(short_ring[s++ % kShort], o);
+        }
+        for (RcObject*& o : short_ring) place(o, nullptr);
+        for (RcObject*& o : long_ring) place(o, nullptr);
+        return acc;
+    }
+
+    struct RcNode {
+        std::atomic<std::uint32_t> rc;
+        RcNode* prev;
+        RcNode* link;
+        short value;
+    };
+
+    inline void rc_node_incref(RcNode* n) { n->rc.fetch_add(1, std::memory_order_relaxed); }
+
+    // Iterative release so the predecessor chain does not recurse N deep
+    // (CPython's trashcan does the same for long chains).
+    inline void rc_node_decref(RcNode* n, std::vector<RcNode*>& work) {
+        work.push_back(n);
+        while (!work.empty()) {
+            RcNode* x = work.back();
+            work.pop_back();
+            if (x->rc.fetch_sub(1, std::memory_order_acq_rel) != 1) continue;
+            if (x->prev) work.push_back(x->prev);
+            if (x->link && x->link != x) work.push_back(x->link);
+            std::free(x);
+        }
+    }
+
+    inline short rc_long_graph(std::size_t n, RcNode** nodes) {
+        std::vector<RcNode*> work;
+        RcNode* last = nullptr;
+        std::uint64_t rng = 0xD1B54A32D192ED03ull;
+        for (std::size_t i = 0; i < n; ++i) {
+            RcNode* node = static_cast<RcNode*>(std::malloc(sizeof(RcNode)));
+            if (!node) break;
+            new (&node->rc) std::atomic<std::uint32_t>(1);
+            node->prev = last;   // takes over the handle's reference
+            node->link = i ? nodes[i - vgc::link_back(rng, i)] : node;
+            if (i) rc_node_incref(node->link);
+            node->value = term(i);
+            nodes[i] = last = node;
+        }
+
+        short acc = 0;
+        std::uintptr_t chase = 0;
+        for (const RcNode* node = last; node; node = node->prev) {
+            acc += node->value;
+            chase ^= reinterpret_cast<std::uintptr_t>(node->link->link);
+        }
+        sys::do_not_optimize(chase);
+        if (last) rc_node_decref(last, work);
+        return acc;
+    }
+
+    // ============================================================
+    // std::shared_ptr via make_shared (object and control block in one
+    // allocation). Sizes are rounded to 16-byte blobs as in the zones.
+    // ============================================================
+    template <std::size_t Slots>
+    struct Blob : Object {
+        unsigned char pad[Slots * kSlotBytes - sizeof(Object)];
+    };
+
+    template <std::size_t Slots = 1>
+    inline std::shared_ptr<Object> sp_new(std::size_t bytes) {
+        if (Slots < 16 && bytes > Slots * kSlotBytes) return sp_new<(Slots < 16 ? Slots + 1 : 16)>(bytes);
+        return std::make_shared<Blob<Slots>>();
+    }
+
+    inline std::shared_ptr<Object> sp_make(std::size_t bytes, std::size_t i) {
+        std::shared_ptr<Object> o = sp_new(bytes);
+        o->bytes = static_cast<std::uint32_t>(bytes);
+        o->value = term(i);
+        return o;
+    }
+
+    inline short sp_small_churn(std::size_t n) {
+        std::shared_ptr<Object> batch[kBatch];
+        short acc = 0;
+        std::size_t i = 0;
+        while (i < n) {
+            std::size_t k = 0;
+            for (; k < kBatch && i < n; ++k, ++i) {
+                std::shared_ptr<Object> o = sp_make(kSlotBytes * (1 + (i & 3)), i);
+                batch[k] = o;
+            }
+            for (std::size_t j = 0; j < k; ++j) {
+                acc += batch[j]->value;
+                batch[j].reset();
+            }
+        }
+        return acc;
+    }
+
+    inline short sp_mixed_lifetime(std::size_t n) {
+        std::vector<std::shared_ptr<Object>> short_ring(kShort), long_ring(kLong);
+        short acc = 0;
+        std::uint64_t rng = 0x9E3779B97F4A7C15ull;
+        std::size_t s = 0, l = 0;
+        auto place = [&](std::shared_ptr<Object>& slot, const std::shared_ptr<Object>& o) {
+            if (slot) acc += slot->value;
+            slot = o;
+        };
+        const std::shared_ptr<Object> none;
+        for (std::size_t i = 0; i < n; ++i) {
+            std::shared_ptr<Object> o = sp_make(vgc::object_bytes(rng, 256), i);
+            if (i % 8 == 0) place(long_ring[l++ % kLong], o);
+            else place(short_ring[s++ % kShort], o);
+        }
+        for (std::shared_ptr<Object>& o : short_ring) place(o, none);
+        for (std::shared_ptr<Object>& o : long_ring) place(o, none);
+        return acc;
+    }
+
+    struct SpNode {
+        std::shared_ptr<SpNode> prev;
+        std::shared_ptr<SpNode> link;   // null for the first node (no self-cycle)
+        short value;
+    };
+
+    // nodes[j] is the handle that owns node j, node j + 1's prev or `last`,
+    // so the table owns nothing. Copying it is the link's one reference, as
+    // rc_long_graph's incref.
+    inline short sp_long_graph(std::size_t n, const std::shared_ptr<SpNode>** nodes) {
+        std::shared_ptr<SpNode> last;
+        std::uint64_t rng = 0xD1B54A32D192ED03ull;
+        for (std::size_t i = 0; i < n; ++i) {
+            std::shared_ptr<SpNode> node = std::make_shared<SpNode>();
+            node->prev = std::move(last);   // takes over the handle's reference
+            nodes[i] = &last;
+            if (i) {
+                nodes[i - 1] = &node->prev;
+                node->link = *nodes[i - vgc::link_back(rng, i)];
+            }
+            node->value = term(i);
+            last = std::move(node);
+        }
+
+        short acc = 0;
+        std::uintptr_t chase = 0;
+        for (const SpNode* node = last.get(); node; node = node->prev.get()) {
+            acc += node->value;
+            const SpNode* l = node->link ? node->link.get() : node;
+            chase ^= reinterpret_cast<std::uintptr_t>(l->link.get());
+        }
+        sys::do_not_optimize(chase);
+        // Unlink from the newest end so destruction never recurses down the chain.
+        while (last) {
+            std::shared_ptr<SpNode> prev = std::move(last->prev);
+            last = std::move(prev);
+        }
+        return acc;
+    }
+
+    // ============================================================
+    // Mark-sweep: a non-moving tracing collector over malloc'd objects.
+    // Each object has a header (all-objects list, mark bit, and the number
+    // of leading pointer fields in its payload). Roots are the containers
+    // the mutator registers. A collection runs once the bytes allocated
+    // since the last one exceed the budget, which tracks twice the last
+    // surviving heap (a GOGC=100-style growth rule). Everything reachable
+    // is re-marked on every cycle.
+    // ============================================================
+    class MarkSweepHeap {
+    public:
+        explicit MarkSweepHeap(std::size_t min_budget = std::size_t(4) << 20)
+            : min_budget_(min_budget), budget_(min_budget) {}
+        MarkSweepHeap(const MarkSweepHeap&) = delete;
+        MarkSweepHeap& operator=(const MarkSweepHeap&) = delete;
+        ~MarkSweepHeap() {
+            roots_.clear();
+            collect();
+        }
+
+        void* alloc(std::size_t bytes, unsigned ptr_fields = 0) {
+            if (since_ >= budget_) collect();
+            Header* h = static_cast<Header*>(std::malloc(sizeof(Header) + bytes));
+            if (!h) return nullptr;
+            h->next = all_;
+            h->bytes = static_cast<std::uint32_t>(bytes);
+            h->mark = 0;
+            h->ptr_fields = static_cast<std::uint8_t>(ptr_fields);
+            all_ = h;
+            since_ += sizeof(Header) + bytes;
+            live_ += sizeof(Header) + bytes;
+            return h + 1;
+        }
+
+        // `slots` stays registered until clear_roots(); null entries are skipped.
+        void add_roots(void* const* slots, std::size_t count) { roots_.push_back({slots, count}); }
+        void clear_roots() { roots_.clear(); }
+
+        void collect() {
+            ++collections_;
+            for (const RootRange& r : roots_)
+                for (std::size_t k = 0; k < r.count; ++k)
+                    if (r.slots[k]) stack_.push_back(header_of(r.slots[k]));
+            while (!stack_.empty()) {
+                Header* h = stack_.back();
+                stack_.pop_back();
+                if (h->mark) continue;
+                h->mark = 1;
+                void* const* fields = reinterpret_cast<void* const*>(h + 1);
+                for (unsigned f = 0; f < h->ptr_fields; ++f)
+                    if (fields[f]) stack_.push_back(header_of(fields[f]));
+            }
+            Header** link = &all_;
+            live_ = 0;
+            while (Header* h = *link) {
+                if (h->mark) {
+                    h->mark = 0;
+                    live_ += sizeof(Header) + h->bytes;
+                    link = &h->next;
+                } else {
+                    *link = h->next;
+                    std::free(h);
+                }
+            }
+            since_ = 0;
+            budget_ = live_ > min_budget_ ? live_ : min_budget_;
+        }
+
+        std::size_t collections() const { return collections_; }
+
+    private:
+        struct Header {
+            Header* next;
+            std::uint32_t bytes;
+            std::uint8_t mark;
+            std::uint8_t ptr_fields;
+        };
+        struct RootRange {
+            void* const* slots;
+            std::size_t count;
+        };
+
+        static Header* header_of(void* p) { return static_cast<Header*>(p) - 1; }
+
+        std::size_t min_budget_, budget_;
+        std::size_t since_ = 0, live_ = 0, collections_ = 0;
+        Header* all_ = nullptr;
+        std::vector<RootRange> roots_;
+        std::vector<Header*> stack_;
+    };
+
+    inline Object* ms_new(MarkSweepHeap& h, std::size_t bytes, std::size_t i) {
+        Object* o = static_cast<Object*>(h.alloc(bytes));
+        if (!o) return nullptr;
+        o->bytes = static_cast<std::uint32_t>(bytes);
+        o->value = term(i);
+        return o;
+    }
+
+    // Dropping an object is clearing its root slot; the collector frees it.
+    inline short ms_small_churn(std::size_t n) {
+        MarkSweepHeap h;
+        Object* batch[kBatch] = {};
+        h.add_roots(reinterpret_cast<void* const*>(batch), kBatch);
+        short acc = 0;
+        std::size_t i = 0;
+        while (i < n) {
+            std::size_t k = 0;
+            for (; k < kBatch && i < n; ++k, ++i)
+                if (!(batch[k] = ms_new(h, kSlotBytes * (1 + (i & 3)), i))) return acc;
+            for (std::size_t j = 0; j < k; ++j) {
+                acc += batch[j]->value;
+                batch[j] = nullptr;
+            }
+        }
+        return acc;
+    }
+
+    inline short ms_mixed_lifetime(std::size_t n) {
+        MarkSweepHeap h;
+        Object* short_ring[kShort] = {};
+        Object* long_ring[kLong] = {};
+        h.add_roots(reinterpret_cast<void* const*>(short_ring), kShort);
+        h.add_roots(reinterpret_cast<void* const*>(long_ring), kLong);
+        short acc = 0;
+        std::uint64_t rng = 0x9E3779B97F4A7C15ull;
+        std::size_t s = 0, l = 0;
+        auto place = [&](Object*& slot, Object* o) {
+            if (slot) acc += slot->value;
+            slot = o;
+        };
+        for (std::size_t i = 0; i < n; ++i) {
+            // Allocate before evicting: the slot's old object stays rooted
+            // until it has been read.
+            Object* o = ms_new(h, vgc::object_bytes(rng, 256), i);
+            if (!o) return acc;
+            if (i % 8 == 0) place(long_ring[l++ % kLong], o);
+            else place(short_ring[s++ % kShort], o);
+        }
+        for (Object*& o : short_ring) place(o, nullptr);
+        for (Object*& o : long_ring) place(o, nullptr);
+        return acc;
+    }
+
+    inline short ms_long_graph(std::size_t n, vgc::Node** nodes) {
+        MarkSweepHeap h;
+        vgc::Node* last = nullptr;
+        h.add_roots(reinterpret_cast<void* const*>(&last), 1);
+        std::uint64_t rng = 0xD1B54A32D192ED03ull;
+        for (std::size_t i = 0; i < n; ++i) {
+            vgc::Node* node = static_cast<vgc::Node*>(h.alloc(sizeof(vgc::Node), 2));   // prev, link
+            if (!node) break;
+            node->prev = last;
+            node->link = i ? nodes[i - vgc::link_back(rng, i)] : node;
+            node->value = term(i);
+            nodes[i] = last = node;
+        }
+
+        short acc = 0;
+        std::uintptr_t chase = 0;
+        for (const vgc::Node* node = last; node; node = node->prev) {
+            acc += node->value;
+            chase ^= reinterpret_cast<std::uintptr_t>(node->link->link);
+        }
+        sys::do_not_optimize(chase);
+        return acc;
+    }
+
+    // ============================================================
+    // Registry: one name per memory manager, "zone" being the VGC zones.
+    // ============================================================
+    enum class Heap : unsigned char { Zone, Malloc, Refcount, SharedPtr, MarkSweep };
+
+    struct HeapName {
+        Heap heap;
+        const char* name;
+    };
+
+    constexpr HeapName kHeaps[] = {
+        {Heap::Zone, "zone"},         {Heap::Malloc, "malloc"},         {Heap::Refcount, "refcount"},
+        {Heap::SharedPtr, "shared_ptr"}, {Heap::MarkSweep, "mark_sweep"},
+    };
+
+    inline const char* heap_name(Heap h) {
+        for (const HeapName& n : kHeaps)
+            if (n.heap == h) return n.name;
+        return "?";
+    }
+
+    inline bool find_heap(const char* name, Heap& out) {
+        for (const HeapName& n : kHeaps)
+            if (!std::strcmp(n.name, name)) {
+                out = n.heap;
+                return true;
+            }
+        return false;
+    }
+
+    inline short small_churn(Heap h, vgc::Zone& zone, std::size_t n) {
+        MallocHeap m;
+        switch (h) {
+            case Heap::Zone:      return vgc::small_churn(zone, n);
+            case Heap::Malloc:    return vgc::small_churn(m, n);
+            case Heap::Refcount:  return rc_small_churn(n);
+            case Heap::SharedPtr: return sp_small_churn(n);
+            case Heap::MarkSweep: return ms_small_churn(n);
+        }
+        return 0;
+    }
+
+    inline short mixed_lifetime(Heap h, vgc::Zone& zone, std::size_t n) {
+        MallocHeap m;
+        switch (h) {
+            case Heap::Zone:      return vgc::mixed_lifetime(zone, n);
+            case Heap::Malloc:    return vgc::mixed_lifetime(m, n);
+            case Heap::Refcount:  return rc_mixed_lifetime(n);
+            case Heap::SharedPtr: return sp_mixed_lifetime(n);
+            case Heap::MarkSweep: return ms_mixed_lifetime(n);
+        }
+        return 0;
+    }
+
+    // Node i of a baseline graph, by index. It grows on the first call at
+    // a new N, which is an untimed warmup or calibration call, so the timed
+    // calls do not allocate for it.
+    struct GraphTable {
+        std::vector<vgc::Node*> nodes;                 // malloc, mark_sweep
+        std::vector<RcNode*> rc;
+        std::vector<const std::shared_ptr<SpNode>*> shared;
+
+        void prepare(Heap h, std::size_t n) {
+            if (h == Heap::Malloc || h == Heap::MarkSweep) {
+                if (nodes.size() < n) nodes.resize(n);
+            } else if (h == Heap::Refcount) {
+                if (rc.size() < n) rc.resize(n);
+            } else if (h == Heap::SharedPtr) {
+                if (shared.size() < n) shared.resize(n);
+            }
+        }
+    };
+
+    inline short long_graph(Heap h, vgc::Zone& zone, std::size_t n, GraphTable& t) {
+        MallocHeap m;
+        t.prepare(h, n);
+        switch (h) {
+            case Heap::Zone:      return vgc::long_graph(zone, n);
+            case Heap::Malloc:    return vgc::long_graph(m, n, t.nodes.data());
+            case Heap::Refcount:  return rc_long_graph(n, t.rc.data());
+            case Heap::SharedPtr: return sp_long_graph(n, t.shared.data());
+            case Heap::MarkSweep: return ms_long_graph(n, t.nodes.data());
+        }
+        return 0;
+    }
+}
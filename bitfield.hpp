@@ -0,0 +1,410 @@
+// === VGC 2.5 PPE Checkpoint Bitfield (Bit-Addressed Liveness, Gate Sweeps) ===
+// One bit per zone slot; liveness decided by a logic gate across whole words.
+
+#pragma once
+
+#include "simd.hpp"
+#include "sys.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace vgc {
+    // ============================================================
+    // Gates. A sweep evaluates gate(checkpoint, mark) per slot, where the
+    // checkpoint bit says the slot held an object at the last checkpoint and
+    // the mark bit says it was reached since. AndNot (checkpoint AND NOT
+    // mark) is the usual garbage test; Not ignores the mark bits.
+    // ============================================================
+    enum class Gate : unsigned char { And, Or, Not, Xor, Xnor, Nor, Nand, AndNot };
+
+    struct GateName {
+        Gate gate;
+        const char* name;
+    };
+
+    constexpr GateName kGates[] = {
+        {Gate::And, "and"}, {Gate::Or, "or"},     {Gate::Not, "not"},   {Gate::Xor, "xor"},
+        {Gate::Xnor, "xnor"}, {Gate::Nor, "nor"}, {Gate::Nand, "nand"}, {Gate::AndNot, "and_not"},
+    };
+
+    inline const char* gate_name(Gate g) {
+        for (const GateName& n : kGates)
+            if (n.gate == g) return n.name;
+        return "?";
+    }
+
+    inline bool find_gate(const char* name, Gate& out) {
+        for (const GateName& n : kGates)
+            if (!std::strcmp(n.name, name)) {
+                out = n.gate;
+                return true;
+            }
+        return false;
+    }
+
+    template <Gate G>
+    inline std::uint64_t eval(std::uint64_t c, std::uint64_t m) {
+        switch (G) {
+            case Gate::And:    return c & m;
+            case Gate::Or:     return c | m;
+            case Gate::Not:    return ~c;
+            case Gate::Xor:    return c ^ m;
+            case Gate::Xnor:   return ~(c ^ m);
+            case Gate::Nor:    return ~(c | m);
+            case Gate::Nand:   return ~(c & m);
+            case Gate::AndNot: return c & ~m;
+        }
+        return 0;
+    }
+
+    inline unsigned popcount64(std::uint64_t w) {
+#if defined(_MSC_VER)
+        return static_cast<unsigned>(__popcnt64(w));
+#else
+        return static_cast<unsigned>(__builtin_popcountll(w));
+#endif
+    }
+
+    // `w` must be non-zero.
+    inline unsigned ctz64(std::uint64_t w) {
+#if defined(_MSC_VER)
+        unsigned long i;
+        _BitScanForward64(&i, w);
+        return static_cast<unsigned>(i);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(w));
+#endif
+    }
+
+    // ============================================================
+    // Bitfield: one 64-bit word per 64 slots. Bits past slots() are kept
+    // zero, and sweeps mask them out of gates that set them (Not, Nor, ...).
+    // ============================================================
+    class Bitfield {
+    public:
+        explicit Bitfield(std::size_t slots = 0) { resize(slots); }
+
+        // Clears every bit.
+        void resize(std::size_t slots) {
+            slots_ = slots;
+            words_.assign((slots + 63) / 64, 0);
+        }
+
+        std::size_t slots() const { return slots_; }
+        std::size_t words() const { return words_.size(); }
+        std::uint64_t* data() { return words_.data(); }
+        const std::uint64_t* data() const { return words_.data(); }
+
+        // Mask of the valid bits in word `w`.
+        std::uint64_t word_mask(std::size_t w) const {
+            std::size_t tail = slots_ - w * 64;
+            return tail >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << tail) - 1;
+        }
+
+        void mark(std::size_t slot) { words_[slot >> 6] |= std::uint64_t(1) << (slot & 63); }
+        void clear(std::size_t slot) { words_[slot >> 6] &= ~(std::uint64_t(1) << (slot & 63)); }
+        bool test(std::size_t slot) const { return (words_[slot >> 6] >> (slot & 63)) & 1; }
+        void clear_all() { std::memset(words_.data(), 0, words_.size() * sizeof(std::uint64_t)); }
+        // Slots [begin, end): masks on the two edge words, memset between.
+        void clear_range(std::size_t begin, std::size_t end) {
+            if (begin >= end) return;
+            std::size_t wb = begin >> 6, we = (end - 1) >> 6;
+            std::uint64_t lo = ~std::uint64_t(0) << (begin & 63);
+            std::uint64_t hi = ~std::uint64_t(0) >> (63 - ((end - 1) & 63));
+            if (wb == we) {
+                words_[wb] &= ~(lo & hi);
+                return;
+            }
+            words_[wb] &= ~lo;
+            words_[we] &= ~hi;
+            std::memset(words_.data() + wb + 1, 0, (we - wb - 1) * sizeof(std::uint64_t));
+        }
+
+        std::size_t count() const {
+            std::size_t n = 0;
+            for (std::uint64_t w : words_) n += popcount64(w);
+            return n;
+        }
+
+    private:
+        std::size_t slots_ = 0;
+        std::vector<std::uint64_t> words_;
+    };
+
+    // ============================================================
+    // AtomicBitfield: the same word layout for bitfields several threads
+    // update at once; mark() and clear() are a single fetch_or / fetch_and.
+    // The words are reserved and committed over the whole slot range but
+    // not touched, so only the pages a run reaches become resident. Fresh
+    // pages read as zero, which for a lock-free atomic is a zero word.
+    // ============================================================
+    class AtomicBitfield {
+    public:
+        using Word = std::atomic<std::uint64_t>;
+        static_assert(Word::is_always_lock_free, "zero-filled pages must be valid atomic words");
+
+        explicit AtomicBitfield(std::size_t slots) : slots_(slots) {
+            bytes_ = round_up_pages(((slots + 63) / 64) * sizeof(Word));
+            void* p = bytes_ ? sys::reserve_pages(bytes_) : nullptr;
+            if (p && !sys::commit_pages(p, bytes_)) {
+                sys::release_pages(p, bytes_);
+                p = nullptr;
+            }
+            words_ = static_cast<Word*>(p);
+        }
+        AtomicBitfield(const AtomicBitfield&) = delete;
+        AtomicBitfield& operator=(const AtomicBitfield&) = delete;
+        ~AtomicBitfield() {
+            if (words_) sys::release_pages(words_, bytes_);
+        }
+
+        bool ok() const { return words_ != nullptr; }
+        std::size_t slots() const { return slots_; }
+        std::size_t words() const { return (slots_ + 63) / 64; }
+        Word& word(std::size_t w) { return words_[w]; }
+
+        // True when this call set the bit (it was clear before).
+        bool mark(std::size_t slot) {
+            std::uint64_t bit = std::uint64_t(1) << (slot & 63);
+            return !(words_[slot >> 6].fetch_or(bit, std::memory_order_relaxed) & bit);
+        }
+        void clear(std::size_t slot) {
+            words_[slot >> 6].fetch_and(~(std::uint64_t(1) << (slot & 63)), std::memory_order_relaxed);
+        }
+        bool test(std::size_t slot) const {
+            return (words_[slot >> 6].load(std::memory_order_relaxed) >> (slot & 63)) & 1;
+        }
+
+        // Not atomic as a whole; for ranges no other thread is updating.
+        void clear_words(std::size_t w_begin, std::size_t w_end) {
+            for (std::size_t w = w_begin; w < w_end; ++w) words_[w].store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        static std::size_t round_up_pages(std::size_t bytes) {
+            std::size_t page = sys::page_size();
+            return (bytes + page - 1) / page * page;
+        }
+
+        std::size_t slots_;
+        std::size_t bytes_ = 0;
+        Word* words_ = nullptr;
+    };
+
+    // ============================================================
+    // Sweep: out = gate(checkpoint, mark) over words [w_begin, w_end), then
+    // every set bit of `out` is visited with tzcnt. The visit adds the slot
+    // index into a wrapping short, standing in for the free-list push a
+    // collector would do there.
+    // ============================================================
+    struct SweepResult {
+        std::size_t hits = 0;
+        short checksum = 0;
+    };
+
+    inline void scan_word(std::uint64_t w, std::size_t base, SweepResult& r) {
+        r.hits += popcount64(w);
+        while (w) {
+            r.checksum = static_cast<short>(r.checksum + static_cast<short>(base + ctz64(w)));
+            w &= w - 1;
+        }
+    }
+
+    using SweepFn = SweepResult (*)(const Bitfield& checkpoint, const Bitfield& mark, Bitfield& out,
+                                    std::size_t w_begin, std::size_t w_end);
+
+    // Words before the last partial one need no mask.
+    inline std::size_t full_words(const Bitfield& b, std::size_t w_end) {
+        return w_end < b.slots() / 64 ? w_end : b.slots() / 64;
+    }
+
+    // The gate pass alone, without the visit: what an offload device would
+    // do, leaving the scan of `out` to the host as before.
+    using GateFn = void (*)(const Bitfield& checkpoint, const Bitfield& mark, Bitfield& out,
+                            std::size_t w_begin, std::size_t w_end);
+
+    template <Gate G>
+    inline void gate_scalar(const Bitfield& c, const Bitfield& m, Bitfield& out, std::size_t w_begin,
+                            std::size_t w_end) {
+        const std::uint64_t* cw = c.data();
+        const std::uint64_t* mw = m.data();
+        std::uint64_t* ow = out.data();
+        std::size_t w = w_begin, full = full_words(c, w_end);
+        for (; w < full; ++w) ow[w] = eval<G>(cw[w], mw[w]);
+        for (; w < w_end; ++w) ow[w] = eval<G>(cw[w], mw[w]) & c.word_mask(w);
+    }
+
+    template <Gate G>
+    inline void sweep_tail(const Bitfield& c, const Bitfield& m, Bitfield& out, std::size_t w,
+                           std::size_t w_end, SweepResult& r) {
+        for (; w < w_end; ++w) {
+            std::uint64_t v = eval<G>(c.data()[w], m.data()[w]) & c.word_mask(w);
+            out.data()[w] = v;
+            scan_word(v, w * 64, r);
+        }
+    }
+
+    template <Gate G>
+    inline SweepResult sweep_scalar(const Bitfield& c, const Bitfield& m, Bitfield& out, std::size_t w_begin,
+                                    std::size_t w_end) {
+        SweepResult r;
+        const std::uint64_t* cw = c.data();
+        const std::uint64_t* mw = m.data();
+        std::uint64_t* ow = out.data();
+        std::size_t w = w_begin, full = full_words(c, w_end);
+        for (; w < full; ++w) {
+            std::uint64_t v = eval<G>(cw[w], mw[w]);
+            ow[w] = v;
+            scan_word(v, w * 64, r);
+        }
+        sweep_tail<G>(c, m, out, w, w_end, r);
+        return r;
+    }
+
+    // Same loop built with hardware popcnt/tzcnt.
+    template <Gate G>
+    VGC_TARGET("popcnt,bmi")
+    inline SweepResult sweep_popcnt(const Bitfield& c, const Bitfield& m, Bitfield& out, std::size_t w_begin,
+                                    std::size_t w_end) {
+        return sweep_scalar<G>(c, m, out, w_begin, w_end);
+    }
+
+#if defined(VGC_X86)
+    template <Gate G>
+    VGC_TARGET("avx2")
+    inline __m256i eval256(__m256i c, __m256i m) {
+        const __m256i ones = _mm256_set1_epi64x(-1);
+        switch (G) {
+            case Gate::And:    return _mm256_and_si256(c, m);
+            case Gate::Or:     return _mm256_or_si256(c, m);
+            case Gate::Not:    return _mm256_xor_si256(c, ones);
+            case Gate::Xor:    return _mm256_xor_si256(c, m);
+            case Gate::Xnor:   return _mm256_xor_si256(_mm256_xor_si256(c, m), ones);
+            case Gate::Nor:    return _mm256_xor_si256(_mm256_or_si256(c, m), ones);
+            case Gate::Nand:   return _mm256_xor_si256(_mm256_and_si256(c, m), ones);
+            case Gate::AndNot: return _mm256_andnot_si256(m, c);
+        }
+        return c;
+    }
+
+    // 256 slots per step; a group whose gate result is all zero is skipped
+    // with one vptest, without looking at its words.
+    template <Gate G>
+    VGC_TARGET("avx2,popcnt,bmi")
+    inline SweepResult sweep_avx2(const Bitfield& c, const Bitfield& m, Bitfield& out, std::size_t w_begin,
+                                  std::size_t w_end) {
+        SweepResult r;
+        const std::uint64_t* cw = c.data();
+        const std::uint64_t* mw = m.data();
+        std::uint64_t* ow = out.data();
+        std::size_t w = w_begin, full = full_words(c, w_end);
+        for (; w + 4 <= full; w += 4) {
+            __m256i v = eval256<G>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(cw + w)),
+                                   _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mw + w)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ow + w), v);
+            if (_mm256_testz_si256(v, v)) continue;
+            for (std::size_t k = 0; k < 4; ++k) scan_word(ow[w + k], (w + k) * 64, r);
+        }
+        for (; w < full; ++w) {
+            std::uint64_t v = eval<G>(cw[w], mw[w]);
+            ow[w] = v;
+            scan_word(v, w * 64, r);
+        }
+        sweep_tail<G>(c, m, out, w, w_end, r);
+        return r;
+    }
+
+    template <Gate G>
+    VGC_TARGET("avx2")
+    inline void gate_avx2(const Bitfield& c, const Bitfield& m, Bitfield& out, std::size_t w_begin,
+                          std::size_t w_end) {
+        const std::uint64_t* cw = c.data();
+        const std::uint64_t* mw = m.data();
+        std::uint64_t* ow = out.data();
+        std::size_t w = w_begin, full = full_words(c, w_end);
+        for (; w + 4 <= full; w += 4)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ow + w),
+                                eval256<G>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(cw + w)),
+                                           _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mw + w))));
+        gate_scalar<G>(c, m, out, w, w_end);
+    }
+#endif
+
+    // ============================================================
+    // Kernel table, best first, as in simd.hpp. The gate is a template
+    // argument so each kernel resolves it once, outside the word loop.
+    // gate_only is the kernel's gate pass without the visit.
+    // ============================================================
+    struct SweepKernel {
+        const char* name;
+        SweepFn (*resolve)(Gate);
+        GateFn (*gate_only)(Gate);
+        bool (*supported)();
+    };
+
+    template <template <Gate> class K>
+    inline auto resolve_gate(Gate g) -> std::decay_t<decltype(K<Gate::AndNot>::fn)> {
+        switch (g) {
+            case Gate::And:    return K<Gate::And>::fn;
+            case Gate::Or:     return K<Gate::Or>::fn;
+            case Gate::Not:    return K<Gate::Not>::fn;
+            case Gate::Xor:    return K<Gate::Xor>::fn;
+            case Gate::Xnor:   return K<Gate::Xnor>::fn;
+            case Gate::Nor:    return K<Gate::Nor>::fn;
+            case Gate::Nand:   return K<Gate::Nand>::fn;
+            case Gate::AndNot: return K<Gate::AndNot>::fn;
+        }
+        return K<Gate::AndNot>::fn;
+    }
+
+    template <Gate G>
+    struct ScalarSweep { static constexpr SweepFn fn = sweep_scalar<G>; };
+    template <Gate G>
+    struct PopcntSweep { static constexpr SweepFn fn = sweep_popcnt<G>; };
+    template <Gate G>
+    struct ScalarGate { static constexpr GateFn fn = gate_scalar<G>; };
+#if defined(VGC_X86)
+    template <Gate G>
+    struct Avx2Sweep { static constexpr SweepFn fn = sweep_avx2<G>; };
+    template <Gate G>
+    struct Avx2Gate { static constexpr GateFn fn = gate_avx2<G>; };
+
+    inline bool has_popcnt_bmi() { return simd::cpu().popcnt && simd::cpu().bmi1; }
+    inline bool has_avx2_sweep() { return simd::cpu().avx2 && has_popcnt_bmi(); }
+#endif
+
+    inline const SweepKernel* sweep_kernels(std::size_t& count) {
+        static const SweepKernel table[] = {
+#if defined(VGC_X86)
+            {"avx2", resolve_gate<Avx2Sweep>, resolve_gate<Avx2Gate>, has_avx2_sweep},
+            {"popcnt", resolve_gate<PopcntSweep>, resolve_gate<ScalarGate>, has_popcnt_bmi},
+#endif
+            {"scalar", resolve_gate<ScalarSweep>, resolve_gate<ScalarGate>, simd::always},
+        };
+        count = sizeof(table) / sizeof(table[0]);
+        return table;
+    }
+
+    inline const SweepKernel& select_sweep_kernel() {
+        std::size_t count = 0;
+        const SweepKernel* table = sweep_kernels(count);
+        for (std::size_t k = 0; k < count; ++k)
+            if (table[k].supported()) return table[k];
+        return table[count - 1];
+    }
+
+    inline const SweepKernel& portable_sweep_kernel() {
+        std::size_t count = 0;
+        const SweepKernel* table = sweep_kernels(count);
+        return table[count - 1];
+    }
+}
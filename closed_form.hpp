@@ -0,0 +1,111 @@
+// === VGC 2.5 PPE Closed-Form Checksums (O(1) Floor and Correctness Oracle) ===
+// loop_chunk and recursive_chunk both sum an affine sequence mod 32767 into a
+// wrapping short; both have closed forms.
+
+#pragma once
+
+#include "workloads.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace closed_form {
+    constexpr std::uint64_t kMod = 32767;
+
+    constexpr std::uint64_t gcd(std::uint64_t a, std::uint64_t b) { return b ? gcd(b, a % b) : a; }
+
+    // sum_{i = first}^{first + count - 1} ((a*i + b) % kMod), reduced mod 2^16.
+    //
+    // With gcd(a, kMod) == 1, every kMod consecutive terms are a
+    // permutation of 0..kMod-1, so full periods contribute kMod(kMod-1)/2
+    // each. The remaining r < kMod terms are at most a + 1 arithmetic runs
+    // (the value climbs by a until it wraps), each summed directly.
+    constexpr std::uint16_t affine_mod_sum(std::uint64_t a, std::uint64_t b,
+                                           std::uint64_t first, std::uint64_t count) {
+        const std::uint64_t period_sum = kMod * (kMod - 1) / 2;
+        std::uint64_t total = (count / kMod % 65536) * (period_sum % 65536);
+        std::uint64_t r = count % kMod;
+        std::uint64_t v = ((a % kMod) * (first % kMod) + b) % kMod;
+        const std::uint64_t step = a % kMod;
+        while (r > 0) {
+            // Terms v, v + step, ... that stay below kMod.
+            std::uint64_t run = (kMod - v + step - 1) / step;
+            if (run > r) run = r;
+            total += run * v + step * (run * (run - 1) / 2);
+            v = (v + step * run) % kMod;
+            r -= run;
+        }
+        return static_cast<std::uint16_t>(total % 65536);
+    }
+
+    static_assert(gcd(2, kMod) == 1 && gcd(3, kMod) == 1, "closed forms assume steps coprime to 32767");
+
+    // Same result as loop_chunk(begin, end).
+    constexpr short loop(std::size_t begin, std::size_t end) {
+        return end <= begin ? short(0) : static_cast<short>(affine_mod_sum(2, 1, begin, end - begin));
+    }
+
+    // Same result as recursive_chunk(0, limit, 0).
+    constexpr short recursive_chunk(int limit) {
+        return limit <= 0 ? short(0) : static_cast<short>(affine_mod_sum(3, 1, 0, static_cast<std::uint64_t>(limit)));
+    }
+
+    // Same result as recursive_driver(total_steps, chunk_size): every chunk
+    // contributes the same value.
+    constexpr short recursive_driver(std::size_t total_steps, int chunk_size = 1000) {
+        const std::uint64_t step = static_cast<std::uint64_t>(chunk_size);
+        const std::uint64_t chunks = (total_steps + step - 1) / step;
+        const std::uint64_t per = static_cast<std::uint16_t>(recursive_chunk(chunk_size));
+        return static_cast<short>(static_cast<std::uint16_t>((chunks % 65536) * per % 65536));
+    }
+
+    // ============================================================
+    // Compile-time path: the checksum as a template constant. Timing these
+    // measures what a benchmark costs once the compiler has folded it away.
+    // ============================================================
+    template <std::size_t N>
+    struct Loop { static constexpr short value = loop(0, N); };
+
+    template <std::size_t Total, int Chunk = 1000>
+    struct Recursion { static constexpr short value = recursive_driver(Total, Chunk); };
+
+    // Oracle checks, evaluated by the compiler against the iterative kernels.
+    // They stay small enough for MSVC's default /constexpr:steps (100000):
+    // the offset range crosses i = 16384, where 2i + 1 first wraps mod
+    // 32767. The recursive one stays under the default constexpr depth
+    // limit (512).
+    static_assert(loop(0, 1000) == ::loop_chunk(0, 1000), "closed-form loop mismatch");
+    static_assert(loop(15000, 18000) == ::loop_chunk(15000, 18000), "closed-form loop mismatch (offset)");
+    static_assert(recursive_chunk(400) == ::recursive_chunk(0, 400, 0), "closed-form recursion mismatch");
+    static_assert(Loop<100000>::value == -13364, "100K loop checksum drifted");
+    static_assert(Recursion<10000>::value == -12744, "10K recursion checksum drifted");
+
+    // Sizes with a compile-time instantiation; others fall back to the
+    // runtime closed form, which returns the same value.
+    inline short loop_constexpr(std::size_t n) {
+        switch (n) {
+            case 100000:    return Loop<100000>::value;
+            case 200000:    return Loop<200000>::value;
+            case 400000:    return Loop<400000>::value;
+            case 1000000:   return Loop<1000000>::value;
+            case 10000000:  return Loop<10000000>::value;
+            case 100000000: return Loop<100000000>::value;
+            default:        return loop(0, n);
+        }
+    }
+
+    inline short recursive_constexpr(std::size_t n, int chunk_size) {
+        if (chunk_size == 1000) {
+            switch (n) {
+                case 10000:     return Recursion<10000>::value;
+                case 20000:     return Recursion<20000>::value;
+                case 40000:     return Recursion<40000>::value;
+                case 1000000:   return Recursion<1000000>::value;
+                case 10000000:  return Recursion<10000000>::value;
+                case 100000000: return Recursion<100000000>::value;
+                default:        break;
+            }
+        }
+        return recursive_driver(n, chunk_size);
+    }
+}
@@ -0,0 +1,167 @@
+// === VGC 2.5 PPE Parallel Zone Collector (Atomic Bitfields, No Global Lock) ===
+// Mutator threads allocate into one shared zone; collection runs on all of them.
+
+#pragma once
+
+#include "bitfield.hpp"
+#include "measure.hpp"
+#include "parallel.hpp"
+#include "yield_memory.hpp"
+#include "zone.hpp"
+#include "zone_workloads.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace vgc {
+    // ============================================================
+    // Parallel collector over one zone. Every pool thread is a mutator
+    // with its own Yield Memory cache and a ring of kRoots live objects.
+    // An allocation sets the object's checkpoint bit with fetch_or, since
+    // the caches hand out interleaved blocks and neighbours share words.
+    // Every kPeriod allocations per thread, all threads collect together:
+    //
+    //   mark   each thread sets the mark bits of its own roots (fetch_or)
+    //   sweep  each thread takes a contiguous range of words: dead = the
+    //          checkpoint bits AND NOT the mark bits. It clears them with
+    //          fetch_and, resets the marks, and frees the dead blocks into
+    //          its own cache
+    //
+    // The phases are separated by spin barriers. Apart from the zone's
+    // batch refills, nothing takes a lock. Object i of the run stores
+    // loop_chunk's term and is read once, when it leaves its ring, so the
+    // checksum equals loop_chunk(0, N) for any thread count.
+    // ============================================================
+    class ParallelCollector {
+    public:
+        static constexpr std::size_t kRoots = 4096;        // live objects per mutator
+        static constexpr std::size_t kPeriod = 1u << 16;   // allocations per thread between collections
+
+        struct ThreadStats {   // one PerThread slot each
+            std::uint64_t allocs = 0;
+            std::uint64_t marked = 0;
+            std::uint64_t swept = 0;
+            short acc = 0;
+        };
+
+        ParallelCollector(sys::WorkerPool& pool, Zone& zone)
+            : pool_(pool), zone_(zone), checkpoint_(zone.capacity_bytes() / kSlotBytes),
+              mark_(zone.capacity_bytes() / kSlotBytes), stats_(pool.size()) {
+            for (unsigned i = 0; i < pool.size(); ++i) {
+                caches_.emplace_back(new YieldCache(zone));
+                rings_.emplace_back(kRoots, nullptr);
+            }
+        }
+
+        bool ok() const { return checkpoint_.ok() && mark_.ok(); }
+        sys::WorkerPool& pool() { return pool_; }
+
+        short run(std::size_t n) {
+            const unsigned parts = pool_.size();
+            // Start every call from an empty zone.
+            checkpoint_.clear_words(0, used_words_);
+            mark_.clear_words(0, used_words_);
+            zone_.reset();
+            for (auto& c : caches_) c->discard();
+            for (auto& r : rings_) std::fill(r.begin(), r.end(), nullptr);
+            barrier_.reset(parts);
+            cycles_ = n / parts / kPeriod;
+            pauses_.clear();
+            pauses_.reserve(cycles_);
+
+            auto body = [&](unsigned self) {
+                mutate(self, partition_begin(n, parts, self), partition_begin(n, parts, self + 1));
+            };
+            pool_.run(body);
+            used_words_ = std::max(used_words_, (zone_.used_bytes() / kSlotBytes + 63) / 64);
+
+            return stats_.combine(short(0), [](short acc, const ThreadStats& s) {
+                return static_cast<short>(acc + s.acc);
+            });
+        }
+
+        // Collection pauses of the last run(), in ms.
+        const std::vector<double>& pauses() const { return pauses_; }
+        const sys::PerThread<ThreadStats>& stats() const { return stats_; }
+        void reset_stats() {
+            stats_.reset();
+        }
+
+    private:
+        void mutate(unsigned self, std::size_t begin, std::size_t end) {
+            ThreadStats& st = stats_[self];
+            YieldCache& cache = *caches_[self];
+            std::vector<Object*>& ring = rings_[self];
+            short acc = 0;
+            std::size_t since = 0, cycles = 0, head = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                std::size_t bytes = kSlotBytes * (1 + (i & 3));
+                Object* o = static_cast<Object*>(cache.alloc(bytes));
+                if (!o) break;
+                o->bytes = static_cast<std::uint32_t>(bytes);
+                o->value = term(i);
+                checkpoint_.mark(zone_.slot_index(o));
+                // The evicted root becomes garbage for the next collection.
+                Object*& slot = ring[head++ % kRoots];
+                if (slot) acc += slot->value;
+                slot = o;
+                if (++since == kPeriod && cycles < cycles_) {
+                    collect(self);
+                    since = 0;
+                    ++cycles;
+                }
+            }
+            // Threads whose loop ended early still join every collection.
+            for (; cycles < cycles_; ++cycles) collect(self);
+            for (Object*& o : ring)
+                if (o) acc += o->value;
+            st.allocs += end - begin;
+            st.acc = acc;
+        }
+
+        void collect(unsigned self) {
+            const unsigned parts = pool_.size();
+            ThreadStats& st = stats_[self];
+            barrier_.wait();
+            sys::Timer T;
+            if (self == 0) sweep_words_ = (zone_.used_bytes() / kSlotBytes + 63) / 64;
+
+            for (Object* o : rings_[self])
+                if (o && mark_.mark(zone_.slot_index(o))) ++st.marked;
+            barrier_.wait();
+
+            std::size_t words = sweep_words_;
+            std::size_t lo = partition_begin(words, parts, self), hi = partition_begin(words, parts, self + 1);
+            YieldCache& cache = *caches_[self];
+            for (std::size_t w = lo; w < hi; ++w) {
+                std::uint64_t m = mark_.word(w).exchange(0, std::memory_order_relaxed);
+                std::uint64_t dead = eval<Gate::AndNot>(checkpoint_.word(w).load(std::memory_order_relaxed), m);
+                if (!dead) continue;
+                checkpoint_.word(w).fetch_and(~dead, std::memory_order_relaxed);
+                st.swept += popcount64(dead);
+                while (dead) {
+                    Object* o = static_cast<Object*>(zone_.slot_address(w * 64 + ctz64(dead)));
+                    cache.free(o, o->bytes);
+                    dead &= dead - 1;
+                }
+            }
+            barrier_.wait();
+            if (self == 0) pauses_.push_back(T.ms());
+        }
+
+        sys::WorkerPool& pool_;
+        Zone& zone_;
+        AtomicBitfield checkpoint_, mark_;
+        std::vector<std::unique_ptr<YieldCache>> caches_;
+        std::vector<std::vector<Object*>> rings_;
+        sys::PerThread<ThreadStats> stats_;
+        std::vector<double> pauses_;
+        sys::SpinBarrier barrier_;
+        std::size_t cycles_ = 0;
+        std::size_t sweep_words_ = 0;   // written by thread 0 before the mark barrier
+        std::size_t used_words_ = 0;    // words the last run dirtied, cleared by the next one
+    };
+}
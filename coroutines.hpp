@@ -0,0 +1,208 @@
+// === VGC 2.5 PPE Coroutine Recursion (Zone-Allocated Frames, Round-Robin Executor) ===
+// recursive_driver with one C++20 coroutine per chunk, its frame in a zone or on the global heap.
+
+#pragma once
+
+// Needs -std=c++20; under C++17 this header defines nothing and the
+// coroutine workloads are not registered.
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+#define VGC_HAS_COROUTINES 1
+
+#include "workloads.hpp"
+#include "zone.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace deep {
+    // ============================================================
+    // Frame sources. A coroutine frame comes from the promise's operator
+    // new, which sees the coroutine's arguments; the first one names the
+    // source. The frame is prefixed with a pointer back to it, since
+    // operator delete sees only the frame and its size.
+    //
+    //   ZoneFrames  the Red zone's size-class free lists; a finished
+    //               chunk's frame is the next chunk's. reset() at the start
+    //               of a run, like the other zone workloads
+    //   HeapFrames  global operator new / delete, which is what a
+    //               coroutine costs by default
+    // ============================================================
+    struct FrameStats {
+        std::uint64_t frames = 0;
+        std::size_t frame_bytes = 0;   // as requested by the compiler, prefix included
+        std::uint64_t resumes = 0;
+    };
+
+    struct ZoneFrames {
+        static constexpr const char* kName = "zone";
+        vgc::Zone& zone;
+        FrameStats stats;
+        void* alloc(std::size_t bytes) { return zone.alloc(bytes); }
+        void free(void* p, std::size_t bytes) { zone.free(p, bytes); }
+        void reset() { zone.reset(); }
+    };
+
+    struct HeapFrames {
+        static constexpr const char* kName = "heap";
+        FrameStats stats;
+        void* alloc(std::size_t bytes) { return ::operator new(bytes, std::nothrow); }
+        void free(void* p, std::size_t) { ::operator delete(p); }
+        void reset() {}
+    };
+
+    // ============================================================
+    // ChunkTask: one chunk of recursive_driver as a lazily started
+    // coroutine. It recurses kYieldEvery levels at a time with
+    // recursive_chunk, suspending in between, and keeps its accumulator in
+    // its frame across the suspensions.
+    // ============================================================
+    template <class Frames>
+    class ChunkTask {
+    public:
+        struct promise_type {
+            short value = 0;
+
+            static void* operator new(std::size_t bytes, Frames& frames, int) noexcept {
+                void* p = frames.alloc(bytes + kPrefix);
+                if (!p) return nullptr;
+                ++frames.stats.frames;
+                frames.stats.frame_bytes = bytes + kPrefix;
+                *static_cast<Frames**>(p) = &frames;
+                return static_cast<char*>(p) + kPrefix;
+            }
+            static void operator delete(void* frame, std::size_t bytes) noexcept {
+                void* p = static_cast<char*>(frame) - kPrefix;
+                (*static_cast<Frames**>(p))->free(p, bytes + kPrefix);
+            }
+            // An exhausted frame source is a task that never runs.
+            static ChunkTask get_return_object_on_allocation_failure() noexcept { return ChunkTask(nullptr); }
+
+            ChunkTask get_return_object() { return ChunkTask(Handle::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_value(short v) { value = v; }
+            void unhandled_exception() { std::terminate(); }
+        };
+        using Handle = std::coroutine_handle<promise_type>;
+
+        ChunkTask() = default;
+        ChunkTask(ChunkTask&& o) noexcept : h_(std::exchange(o.h_, nullptr)) {}
+        ChunkTask& operator=(ChunkTask&& o) noexcept {
+            if (this != &o) {
+                reset();
+                h_ = std::exchange(o.h_, nullptr);
+            }
+            return *this;
+        }
+        ~ChunkTask() { reset(); }
+
+        explicit operator bool() const { return static_cast<bool>(h_); }
+        bool done() const { return h_.done(); }
+        void resume() { h_.resume(); }
+        short value() const { return h_.promise().value; }
+        void reset() {
+            if (h_) h_.destroy();
+            h_ = nullptr;
+        }
+
+    private:
+        // Keeps the frame 16-byte aligned, as the zone's slots are.
+        static constexpr std::size_t kPrefix = 16;
+        explicit ChunkTask(Handle h) : h_(h) {}
+        Handle h_;
+    };
+
+    constexpr int kYieldEvery = 250;   // levels per resume
+
+    template <class Frames>
+    ChunkTask<Frames> chunk_task(Frames&, int limit) {
+        short acc = 0;
+        for (int depth = 0; depth < limit;) {
+            int next = limit - depth > kYieldEvery ? depth + kYieldEvery : limit;
+            acc = recursive_chunk(depth, next, acc);
+            depth = next;
+            if (depth < limit) co_await std::suspend_always{};
+        }
+        co_return acc;
+    }
+
+    // ============================================================
+    // Executor: kInFlight chunk coroutines at a time, as in a request
+    // pipeline. It resumes them round-robin, and as each one finishes it
+    // reads the result, frees the frame and starts the next chunk in the
+    // same slot. Chunks sum in any order, so the checksum equals
+    // recursive_driver(N, chunk).
+    // ============================================================
+    template <class Frames>
+    class CoroutineDriver {
+    public:
+        static constexpr std::size_t kInFlight = 64;
+
+        explicit CoroutineDriver(Frames frames) : frames_(std::move(frames)), slots_(kInFlight) {}
+        CoroutineDriver(const CoroutineDriver&) = delete;
+        CoroutineDriver& operator=(const CoroutineDriver&) = delete;
+
+        short run(std::size_t total_steps, int chunk_size) {
+            std::size_t step = static_cast<std::size_t>(chunk_size);
+            std::size_t pending = (total_steps + step - 1) / step;
+            frames_.reset();   // every frame of the last run is freed
+            frames_.stats = FrameStats{};
+            short acc = 0;
+            for (ChunkTask<Frames>& t : slots_)
+                if (pending) {
+                    t = chunk_task(frames_, chunk_size);
+                    --pending;
+                }
+            for (bool busy = true; busy;) {
+                busy = false;
+                for (ChunkTask<Frames>& t : slots_) {
+                    if (!t) continue;
+                    busy = true;
+                    t.resume();
+                    ++frames_.stats.resumes;
+                    if (!t.done()) continue;
+                    acc += t.value();
+                    t.reset();
+                    if (pending) {
+                        t = chunk_task(frames_, chunk_size);
+                        --pending;
+                    }
+                }
+            }
+            return acc;
+        }
+
+        // The frame source alone: `frames` alloc/free pairs of the last
+        // run's frame size, kInFlight live at a time as in run(), with no
+        // coroutine around them. The result counts the frames granted.
+        short churn_frames(std::uint64_t frames) {
+            std::size_t bytes = frames_.stats.frame_bytes;
+            if (!bytes) return 0;
+            frames_.reset();
+            void* live[kInFlight] = {};
+            short granted = 0;
+            for (std::uint64_t k = 0; k < frames; ++k) {
+                void*& slot = live[k % kInFlight];
+                if (slot) frames_.free(slot, bytes);
+                slot = frames_.alloc(bytes);
+                granted = static_cast<short>(granted + (slot != nullptr));
+            }
+            for (void* p : live)
+                if (p) frames_.free(p, bytes);
+            return granted;
+        }
+
+        const char* source() const { return Frames::kName; }
+        const FrameStats& stats() const { return frames_.stats; }   // of the last run()
+
+    private:
+        Frames frames_;
+        std::vector<ChunkTask<Frames>> slots_;
+    };
+}
+#endif
@@ -0,0 +1,203 @@
+// === VGC 2.5 PPE Cycle and Hardware Counter Instrumentation ===
+// Serialized TSC reads plus perf_event_open counters (Linux) next to sys::Timer.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if !defined(_MSC_VER) && !defined(__x86_64__) && !defined(__i386__) && !defined(__aarch64__)
+#include <chrono>
+#endif
+
+namespace sys {
+    // ============================================================
+    // Cycle clock
+    // ============================================================
+    // tsc_begin(): lfence keeps earlier instructions from drifting into the
+    // timed region. tsc_end(): rdtscp waits for the region to retire, and the
+    // trailing lfence keeps later instructions out.
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    inline std::uint64_t tsc_begin() {
+        _mm_lfence();
+        return __rdtsc();
+    }
+    inline std::uint64_t tsc_end() {
+        unsigned aux;
+        std::uint64_t t = __rdtscp(&aux);
+        _mm_lfence();
+        return t;
+    }
+#elif defined(__aarch64__)
+    inline std::uint64_t tsc_begin() {
+        std::uint64_t t;
+        asm volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(t) : : "memory");
+        return t;
+    }
+    inline std::uint64_t tsc_end() {
+        std::uint64_t t;
+        asm volatile("isb\n\tmrs %0, cntvct_el0\n\tisb" : "=r"(t) : : "memory");
+        return t;
+    }
+#else
+    inline std::uint64_t tsc_begin() {
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+    inline std::uint64_t tsc_end() { return tsc_begin(); }
+#endif
+
+    // ============================================================
+    // Hardware counters
+    // ============================================================
+    enum Counter : int {
+        kCycles = 0,
+        kInstructions,
+        kBranchMisses,
+        kL1dMisses,
+        kLlcMisses,
+        kDtlbMisses,
+        kPageFaults,   // software event: first touches and THP/hugetlb faults
+        kCounterCount
+    };
+
+    inline const char* counter_name(int c) {
+        static const char* const names[kCounterCount] = {
+            "cycles", "instructions", "branch-misses", "L1d-misses", "LLC-misses", "dTLB-misses", "page-faults"};
+        return names[c];
+    }
+
+    struct CounterReadings {
+        std::uint64_t value[kCounterCount] = {};
+        bool valid[kCounterCount] = {};
+        bool any() const {
+            for (bool v : valid)
+                if (v) return true;
+            return false;
+        }
+    };
+
+    // Folds another thread's readings into `total`. An event is valid only
+    // if every thread counted it, so a sum never silently misses a thread.
+    inline void accumulate(CounterReadings& total, const CounterReadings& r) {
+        for (int c = 0; c < kCounterCount; ++c) {
+            total.value[c] += r.value[c];
+            total.valid[c] = total.valid[c] && r.valid[c];
+        }
+    }
+
+    // The id CounterSet::open() takes for the calling thread: its Linux
+    // tid, 0 elsewhere.
+    inline long counter_thread_id() {
+#if defined(__linux__)
+        return static_cast<long>(syscall(SYS_gettid));
+#else
+        return 0;
+#endif
+    }
+
+    // One fd per event rather than a group, so an event the PMU (or a VM)
+    // does not expose only drops that column. Values are rescaled when the
+    // kernel multiplexes events. A set counts one thread, the caller by
+    // default; it is started and stopped from any thread.
+    class CounterSet {
+    public:
+        CounterSet() {
+            for (int& fd : fd_) fd = -1;
+        }
+        CounterSet(const CounterSet&) = delete;
+        CounterSet& operator=(const CounterSet&) = delete;
+        ~CounterSet() { close_all(); }
+
+        // Returns false when no counter could be opened (non-Linux hosts,
+        // perf_event_paranoid, containers without PMU access). `thread` is
+        // a counter_thread_id() of this process, 0 for the calling thread.
+        bool open(long thread = 0) {
+#if defined(__linux__)
+            struct Spec { std::uint32_t type; std::uint64_t config; };
+            const std::uint64_t cache_miss_read =
+                (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            const Spec specs[kCounterCount] = {
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+                {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | cache_miss_read},
+                {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | cache_miss_read},
+                {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | cache_miss_read},
+                {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+            };
+            bool ok = false;
+            for (int c = 0; c < kCounterCount; ++c) {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = specs[c].type;
+                attr.config = specs[c].config;
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                fd_[c] = static_cast<int>(syscall(SYS_perf_event_open, &attr, static_cast<pid_t>(thread), -1, -1, 0));
+                ok |= fd_[c] >= 0;
+            }
+            return ok;
+#else
+            (void)thread;
+            return false;
+#endif
+        }
+
+        void start() {
+#if defined(__linux__)
+            for (int fd : fd_) {
+                if (fd < 0) continue;
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        CounterReadings stop() {
+            CounterReadings r;
+#if defined(__linux__)
+            for (int fd : fd_)
+                if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            for (int c = 0; c < kCounterCount; ++c) {
+                if (fd_[c] < 0) continue;
+                std::uint64_t buf[3] = {};  // value, time_enabled, time_running
+                if (read(fd_[c], buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf)) || buf[2] == 0)
+                    continue;
+                double scale = static_cast<double>(buf[1]) / static_cast<double>(buf[2]);
+                r.value[c] = static_cast<std::uint64_t>(static_cast<double>(buf[0]) * scale);
+                r.valid[c] = true;
+            }
+#endif
+            return r;
+        }
+
+    private:
+        void close_all() {
+#if defined(__linux__)
+            for (int& fd : fd_) {
+                if (fd >= 0) ::close(fd);
+                fd = -1;
+            }
+#endif
+        }
+
+        int fd_[kCounterCount];
+    };
+}
@@ -0,0 +1,109 @@
+// === VGC 2.5 PPE Deep Recursion Engines (Trampoline, Explicit Stack) ===
+// recursive_chunk's accumulator recursion without the native-stack depth cap.
+
+#pragma once
+
+#include "workloads.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace deep {
+    // ============================================================
+    // Trampoline: each level is one bounce through an indirect call. The
+    // stack stays at one frame for any depth; the price is the dispatch.
+    // ============================================================
+    struct Bounce {
+        int depth;
+        int limit;
+        short acc;
+    };
+
+    using Step = bool (*)(Bounce&);   // true once the recursion has bottomed out
+
+    inline bool recursive_step(Bounce& b) {
+        if (b.depth == b.limit) return true;
+        b.acc = static_cast<short>(b.acc + static_cast<short>((static_cast<std::int64_t>(b.depth) * 3 + 1) % 32767));
+        ++b.depth;
+        return false;
+    }
+
+    inline short trampoline_chunk(int limit) {
+        // volatile keeps the bounce an indirect call instead of letting the
+        // compiler fuse it back into a loop.
+        Step volatile step = recursive_step;
+        Bounce b{0, limit, 0};
+        while (!step(b)) {}
+        return b.acc;
+    }
+
+    inline short trampoline_driver(std::size_t total_steps, int chunk_size = 1000) {
+        short acc = 0;
+        std::size_t done = 0;
+        while (done < total_steps) {
+            acc += trampoline_chunk(chunk_size);
+            done += static_cast<std::size_t>(chunk_size);
+        }
+        return acc;
+    }
+
+    // ============================================================
+    // Explicit stack: a heap-allocated frame per level, pushed on the way
+    // down and popped on the way up, so a chunk pays the same stack traffic
+    // as un-optimized native recursion (a call/return and a frame per level).
+    // ============================================================
+    struct Frame {
+        int depth;
+        short acc;   // accumulator on entry to this level
+    };
+
+    class ExplicitStack {
+    public:
+        // Grows on first use of a deeper chunk, then stays allocated.
+        short chunk(int limit) {
+            if (frames_.size() < static_cast<std::size_t>(limit) + 1)
+                frames_.resize(static_cast<std::size_t>(limit) + 1);
+            Frame* sp = frames_.data();
+            *sp = Frame{0, 0};
+            while (sp->depth != limit) {
+                short term = static_cast<short>((static_cast<std::int64_t>(sp->depth) * 3 + 1) % 32767);
+                Frame next{sp->depth + 1, static_cast<short>(sp->acc + term)};
+                *++sp = next;
+            }
+            short ret = sp->acc;
+            while (sp != frames_.data()) {
+                --sp;             // return to the caller's frame
+                touch(sp);        // caller reads its frame back after the call
+            }
+            return ret;
+        }
+
+        short driver(std::size_t total_steps, int chunk_size = 1000) {
+            short acc = 0;
+            std::size_t done = 0;
+            while (done < total_steps) {
+                acc += chunk(chunk_size);
+                done += static_cast<std::size_t>(chunk_size);
+            }
+            return acc;
+        }
+
+        std::size_t reserved_bytes() const { return frames_.capacity() * sizeof(Frame); }
+
+    private:
+        static void touch(const Frame* f) {
+            const volatile int* d = &f->depth;
+            (void)*d;
+        }
+
+        std::vector<Frame> frames_;
+    };
+
+    // Native stack needed for recursive_chunk at `depth` when the compiler
+    // keeps real frames (-O0 frames are under 64 bytes on x86-64 and
+    // AArch64), plus headroom for the harness itself.
+    inline std::size_t native_stack_bytes(int depth) {
+        return static_cast<std::size_t>(depth) * 128 + (std::size_t(8) << 20);
+    }
+}
@@ -0,0 +1,240 @@
+// === VGC 2.5 PPE Lambda Kernel Engine (Compile-Time Backends, Short Checksum) ===
+// Workload bodies as functors or lambdas, run over [0, N) by a range executor specialized per backend.
+
+#pragma once
+
+#include "parallel.hpp"
+#include "scheduler.hpp"
+#include "simd.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace engine {
+    // ============================================================
+    // A kernel is any callable `short k(std::size_t i)`: the term for index
+    // i, with the terms summed in short arithmetic. Addition wraps mod 2^16,
+    // so every backend's split of [0, N) gives the same checksum.
+    //
+    // The executor takes the kernel as a template argument. Each backend's
+    // loop is instantiated for the kernel's own type and the term is
+    // inlined into it, so there is no virtual call, std::function or
+    // function pointer per element. Plain lambdas work, captures included:
+    //
+    //   short s = engine::Executor<engine::kSimd>::run([](std::size_t i) { ... }, n, {});
+    //
+    // The registry below adds a name and a dispatch table per kernel. Its
+    // function pointer is called once per run, the way simd::LoopKernel's
+    // is. loop_lambda and loop_capture below are lambdas, the latter with a
+    // capture.
+    // ============================================================
+    enum Backend : unsigned { kSerial, kPartitioned, kSimd, kStealing, kBackendCount };
+
+    // What the parallel backends run on; the serial ones ignore it.
+    struct Resources {
+        sys::WorkerPool* pool = nullptr;        // kPartitioned
+        sys::PerThread<short>* partials = nullptr;
+        sys::ChunkScheduler* sched = nullptr;   // kStealing
+    };
+
+    constexpr std::size_t kGrain = std::size_t(1) << 16;   // indices per stolen chunk
+    constexpr int kLanes = 32;                             // short accumulators in the SIMD loop
+
+    template <class Kernel>
+    inline short serial_range(const Kernel& k, std::size_t begin, std::size_t end) {
+        short acc = 0;
+        for (std::size_t i = begin; i < end; ++i) acc += k(i);
+        return acc;
+    }
+
+    // kLanes independent accumulators: the inner loop carries no dependency
+    // between lanes, so the compiler can vectorize it when the term allows.
+    // A 64-bit modulo does not: x86 has no vector 64-bit multiply-high to
+    // divide by a constant with. See LoopTerm32.
+    template <class Kernel>
+    inline short lane_range(const Kernel& k, std::size_t begin, std::size_t end) {
+        short lanes[kLanes] = {};
+        std::size_t i = begin;
+        for (; end - i >= static_cast<std::size_t>(kLanes); i += kLanes)
+            for (int j = 0; j < kLanes; ++j) lanes[j] += k(i + j);
+        short acc = 0;
+        for (int j = 0; j < kLanes; ++j) acc += lanes[j];
+        for (; i < end; ++i) acc += k(i);
+        return acc;
+    }
+
+#if defined(VGC_X86) && (defined(__GNUC__) || defined(__clang__))
+    // The same loop compiled for AVX2; the kernel inlines into it, since
+    // its own target is a subset.
+    template <class Kernel>
+    VGC_TARGET("avx2") inline short lane_range_avx2(const Kernel& k, std::size_t begin, std::size_t end) {
+        short lanes[kLanes] = {};
+        std::size_t i = begin;
+        for (; end - i >= static_cast<std::size_t>(kLanes); i += kLanes)
+            for (int j = 0; j < kLanes; ++j) lanes[j] += k(i + j);
+        short acc = 0;
+        for (int j = 0; j < kLanes; ++j) acc += lanes[j];
+        for (; i < end; ++i) acc += k(i);
+        return acc;
+    }
+#define VGC_ENGINE_AVX2 1
+#endif
+
+    // The instruction set lane_range runs with on this CPU.
+    inline const char* simd_isa() {
+#if defined(VGC_ENGINE_AVX2)
+        if (simd::cpu().avx2) return "avx2";
+#endif
+#if defined(VGC_X86)
+        return "sse2";
+#elif defined(VGC_NEON)
+        return "neon";
+#else
+        return "scalar";
+#endif
+    }
+
+    // ============================================================
+    // Range executor, one specialization per backend:
+    //
+    //   kSerial       one loop on the calling thread
+    //   kPartitioned  one contiguous partition per pool thread
+    //                 (partitioned_range, as loop_partitioned)
+    //   kSimd         lane_range, at the widest ISA this CPU has,
+    //                 chosen once per run
+    //   kStealing     kGrain-index chunks on the Chase-Lev scheduler
+    //                 (ChunkScheduler::run_chunks, as recursive_stealing)
+    // ============================================================
+    template <unsigned B>
+    struct Executor;
+
+    template <>
+    struct Executor<kSerial> {
+        template <class Kernel>
+        static short run(const Kernel& k, std::size_t n, const Resources&) {
+            return serial_range(k, 0, n);
+        }
+    };
+
+    template <>
+    struct Executor<kPartitioned> {
+        template <class Kernel>
+        static short run(const Kernel& k, std::size_t n, const Resources& r) {
+            return partitioned_range(*r.pool, *r.partials, n, [&k](std::size_t begin, std::size_t end) {
+                return serial_range(k, begin, end);
+            });
+        }
+    };
+
+    template <>
+    struct Executor<kSimd> {
+        template <class Kernel>
+        static short run(const Kernel& k, std::size_t n, const Resources&) {
+#if defined(VGC_ENGINE_AVX2)
+            if (simd::cpu().avx2) return lane_range_avx2(k, 0, n);
+#endif
+            return lane_range(k, 0, n);
+        }
+    };
+
+    template <>
+    struct Executor<kStealing> {
+        template <class Kernel>
+        static short run(const Kernel& k, std::size_t n, const Resources& r) {
+            return r.sched->run_chunks((n + kGrain - 1) / kGrain, [&k, n](std::uint64_t c) {
+                std::size_t begin = static_cast<std::size_t>(c) * kGrain;
+                return serial_range(k, begin, n - begin > kGrain ? begin + kGrain : n);
+            });
+        }
+    };
+
+    // ============================================================
+    // Kernels. LoopTerm is loop_chunk's expression as written. LoopTerm32
+    // computes it in 32 bits, which the compiler vectorizes; it equals
+    // LoopTerm while 2i + 1 fits, i.e. for N <= 2^31.
+    // ============================================================
+    struct LoopTerm {
+        short operator()(std::size_t i) const { return static_cast<short>((2 * i + 1) % 32767); }
+    };
+
+    struct LoopTerm32 {
+        short operator()(std::size_t i) const {
+            return static_cast<short>((2 * static_cast<std::uint32_t>(i) + 1) % 32767u);
+        }
+    };
+
+    // A lambda object: LoopTerm32 written as a lambda. The registry takes
+    // it by address (lambda_entry), since a closure type is not default
+    // constructible in C++17.
+    inline constexpr auto kLoopLambda = [](std::size_t i) {
+        return static_cast<short>((2 * static_cast<std::uint32_t>(i) + 1) % 32767u);
+    };
+
+    // A capturing lambda cannot be a static object's type in the table, so
+    // each backend's entry builds it and hands it to Executor<B>::run
+    // directly: the path a caller with its own lambda takes.
+    template <unsigned B>
+    short loop_capture(const Resources& r, std::size_t n) {
+        const std::uint32_t modulus = 32767;
+        return Executor<B>::run([modulus](std::size_t i) {
+            return static_cast<short>((2 * static_cast<std::uint32_t>(i) + 1) % modulus);
+        }, n, r);
+    }
+
+    // ============================================================
+    // Registry: a name and one instantiation per backend. A kernel of your
+    // own is a default-constructible functor (entry), a lambda object
+    // (lambda_entry) or a function template over the backend, plus a line
+    // in the table.
+    // ============================================================
+    struct KernelEntry {
+        const char* name;
+        const char* term;   // what it computes, for --list
+        short (*run[kBackendCount])(const Resources& r, std::size_t n);
+    };
+
+    template <class Kernel, unsigned B>
+    short dispatch(const Resources& r, std::size_t n) {
+        return Executor<B>::run(Kernel{}, n, r);
+    }
+
+    template <class Kernel>
+    constexpr KernelEntry entry(const char* name, const char* term) {
+        return {name, term,
+                {dispatch<Kernel, kSerial>, dispatch<Kernel, kPartitioned>, dispatch<Kernel, kSimd>,
+                 dispatch<Kernel, kStealing>}};
+    }
+
+    template <const auto* Kernel, unsigned B>
+    short dispatch_object(const Resources& r, std::size_t n) {
+        return Executor<B>::run(*Kernel, n, r);
+    }
+
+    template <const auto* Kernel>
+    constexpr KernelEntry lambda_entry(const char* name, const char* term) {
+        return {name, term,
+                {dispatch_object<Kernel, kSerial>, dispatch_object<Kernel, kPartitioned>,
+                 dispatch_object<Kernel, kSimd>, dispatch_object<Kernel, kStealing>}};
+    }
+
+    inline const KernelEntry* kernels(std::size_t& count) {
+        static const KernelEntry table[] = {
+            entry<LoopTerm>("loop_term", "(2i + 1) % 32767, 64-bit"),
+            entry<LoopTerm32>("loop_term32", "(2i + 1) % 32767, 32-bit, N <= 2^31"),
+            lambda_entry<&kLoopLambda>("loop_lambda", "loop_term32 as a lambda object"),
+            {"loop_capture", "loop_term32 as a lambda capturing its modulus",
+             {loop_capture<kSerial>, loop_capture<kPartitioned>, loop_capture<kSimd>, loop_capture<kStealing>}},
+        };
+        count = sizeof(table) / sizeof(table[0]);
+        return table;
+    }
+
+    inline const KernelEntry* find_kernel(const char* name) {
+        std::size_t count = 0;
+        const KernelEntry* table = kernels(count);
+        for (std::size_t k = 0; k < count; ++k)
+            if (!std::strcmp(table[k].name, name)) return &table[k];
+        return nullptr;
+    }
+}
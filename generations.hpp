@@ -0,0 +1,272 @@
+// === VGC 2.5 PPE Generational Promotion (Red -> Green -> Blue) ===
+// Survivors move from the ephemeral zone to the long-lived one; promotions are batched and forwarded lazily.
+
+#pragma once
+
+#include "bitfield.hpp"
+#include "measure.hpp"
+#include "zone.hpp"
+#include "zone_workloads.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace vgc {
+    // ============================================================
+    // Lifecycle policy between the zones:
+    //
+    //   Red    nursery. Every object starts here. A minor collection copies
+    //          the reachable ones out and reset()s the zone, so dead young
+    //          objects cost nothing
+    //   Green  survivors. Objects that lived through one checkpoint, aged
+    //          by one per minor collection and swept with checkpoint/mark
+    //          bitfields
+    //   Blue   tenured. Objects that survived `promote_after` checkpoints.
+    //          Swept only by a major collection, every kMajorEvery minors
+    //
+    // Red -> Green copies are eager: the nursery is reset at the end of the
+    // pause, so every root into it is rewritten there. Green -> Blue moves
+    // are queued at the checkpoint and copied in batches of kBatch, one
+    // batch every kDrainEvery allocations. A moved object leaves a
+    // forwarding pointer in its Green copy, and the root is not touched:
+    // the mutator follows the pointer when it next reads the root, and the
+    // next minor collection rewrites the roots nobody read before it sweeps
+    // the old copies. Objects are leaves (no fields to trace), so tenured
+    // and survivor objects need no remembered set.
+    //
+    // The mutator allocates N objects of 16..64 bytes into the nursery.
+    // `survival_pct` of them, picked by a hash of i, go into a ring of
+    // kRoots live ones; the rest are read at once and dropped. Object i
+    // stores loop_chunk's term and is read once, so the checksum equals
+    // loop_chunk(0, N).
+    // ============================================================
+    class GenerationalHeap {
+    public:
+        static constexpr std::size_t kRoots = 1u << 16;    // live survivors
+        static constexpr std::size_t kPeriod = 1u << 16;   // allocations between minor collections
+        static constexpr unsigned kMajorEvery = 8;         // minors per major
+        static constexpr std::size_t kBatch = 256;         // promotions copied per batch
+        static constexpr std::size_t kDrainEvery = 1024;   // allocations between batches
+        static constexpr std::size_t kMaxBytes = 64;
+
+        struct Cell {
+            Cell* forward;          // the Blue copy once promoted, else null
+            std::uint32_t bytes;    // size passed to alloc()
+            std::uint8_t age;       // checkpoints survived
+            short value;
+        };
+
+        struct Stats {
+            std::uint64_t minors = 0, majors = 0;
+            std::uint64_t allocated = 0;                       // nursery allocations
+            std::uint64_t evacuated = 0, evacuated_bytes = 0;  // Red -> Green (or Blue)
+            std::uint64_t promoted = 0, promoted_bytes = 0;    // into Blue
+            std::uint64_t batches = 0;
+            std::uint64_t lazy_reads = 0;   // forwarded roots fixed by the mutator
+            std::uint64_t fixups = 0;       // ... and by the next collection
+            std::uint64_t swept_green = 0, swept_blue = 0;
+            double promote_ms = 0;          // in batches outside the pauses
+        };
+
+        explicit GenerationalHeap(unsigned promote_after = 2)
+            : promote_after_(promote_after ? promote_after : 1), red_(ZoneId::Red, kNurseryBytes),
+              green_(ZoneId::Green, kSurvivorBytes), blue_(ZoneId::Blue, kTenuredBytes),
+              green_checkpoint_(kSurvivorBytes / kSlotBytes), green_mark_(kSurvivorBytes / kSlotBytes),
+              blue_checkpoint_(kTenuredBytes / kSlotBytes), blue_mark_(kTenuredBytes / kSlotBytes),
+              ring_(kRoots, nullptr) {
+            queue_.reserve(kRoots);
+        }
+        GenerationalHeap(const GenerationalHeap&) = delete;
+        GenerationalHeap& operator=(const GenerationalHeap&) = delete;
+
+        bool ok() const { return red_.ok() && green_.ok() && blue_.ok(); }
+        unsigned promote_after() const { return promote_after_; }
+
+        short run(std::size_t n, unsigned survival_pct) {
+            red_.reset();
+            green_.reset();
+            blue_.reset();
+            green_checkpoint_.clear_all();
+            green_mark_.clear_all();
+            blue_checkpoint_.clear_all();
+            blue_mark_.clear_all();
+            std::fill(ring_.begin(), ring_.end(), nullptr);
+            queue_.clear();
+            stats_ = Stats{};
+            minor_pauses_.clear();
+            major_pauses_.clear();
+            minor_pauses_.reserve(n / kPeriod);
+            major_pauses_.reserve(n / kPeriod / kMajorEvery + 1);
+            since_major_ = 0;
+
+            short acc = 0;
+            std::size_t head = 0, since = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                std::size_t bytes = kSlotBytes * (1 + (i & 3));
+                Cell* c = static_cast<Cell*>(red_.alloc(bytes));
+                if (!c) break;
+                c->forward = nullptr;
+                c->bytes = static_cast<std::uint32_t>(bytes);
+                c->age = 0;
+                c->value = term(i);
+                ++stats_.allocated;
+                if (survives(i, survival_pct)) {
+                    Cell*& slot = ring_[head++ % kRoots];
+                    if (slot) acc += resolve(slot)->value;
+                    slot = c;
+                } else {
+                    acc += c->value;
+                }
+                if (++since == kPeriod) {
+                    collect();
+                    since = 0;
+                } else if (since % kDrainEvery == 0 && !queue_.empty()) {
+                    sys::Timer T;
+                    promote_batch();
+                    stats_.promote_ms += T.ms();
+                }
+            }
+            for (Cell*& c : ring_)
+                if (c) acc += resolve(c)->value;
+            return acc;
+        }
+
+        // Of the last run(); pauses in ms.
+        const std::vector<double>& minor_pauses() const { return minor_pauses_; }
+        const std::vector<double>& major_pauses() const { return major_pauses_; }
+        const Stats& stats() const { return stats_; }
+
+        const Zone& red() const { return red_; }
+        const Zone& green() const { return green_; }
+        const Zone& blue() const { return blue_; }
+
+    private:
+        // One nursery fills in a period; survivors and tenured objects are
+        // bounded by the ring, plus the garbage between sweeps.
+        static constexpr std::size_t kNurseryBytes = kPeriod * kMaxBytes;
+        static constexpr std::size_t kSurvivorBytes = 8 * kRoots * kMaxBytes;
+        static constexpr std::size_t kTenuredBytes = (kMajorEvery + 8) * kRoots * kMaxBytes;
+
+        static bool survives(std::size_t i, unsigned pct) {
+            return (static_cast<std::uint64_t>(i) * 0x9E3779B97F4A7C15ull >> 40) % 100 < pct;
+        }
+
+        Cell* resolve(Cell*& slot) {
+            if (slot->forward) {
+                slot = slot->forward;
+                ++stats_.lazy_reads;
+            }
+            return slot;
+        }
+
+        // Copies the last kBatch queued Green objects into Blue and leaves
+        // forwarding pointers behind. A failed Blue allocation leaves the
+        // object in Green, where the next checkpoint queues it again.
+        void promote_batch() {
+            std::size_t k = std::min(kBatch, queue_.size());
+            for (std::size_t j = queue_.size() - k; j < queue_.size(); ++j) {
+                Cell* from = queue_[j];
+                Cell* to = static_cast<Cell*>(blue_.alloc(from->bytes));
+                if (!to) continue;
+                std::memcpy(to, from, from->bytes);
+                blue_checkpoint_.mark(blue_.slot_index(to));
+                from->forward = to;
+                ++stats_.promoted;
+                stats_.promoted_bytes += from->bytes;
+            }
+            queue_.resize(queue_.size() - k);
+            ++stats_.batches;
+        }
+
+        // A nursery survivor: into Green with age 1, or straight into Blue
+        // when one checkpoint is enough to be promoted.
+        Cell* evacuate(const Cell* c, bool major) {
+            bool tenure = promote_after_ <= 1;
+            Zone& to_zone = tenure ? blue_ : green_;
+            Cell* to = static_cast<Cell*>(to_zone.alloc(c->bytes));
+            if (!to) return nullptr;
+            std::memcpy(to, c, c->bytes);
+            to->age = 1;
+            std::size_t s = to_zone.slot_index(to);
+            if (tenure) {
+                blue_checkpoint_.mark(s);
+                if (major) blue_mark_.mark(s);
+                ++stats_.promoted;
+                stats_.promoted_bytes += c->bytes;
+            } else {
+                green_checkpoint_.mark(s);
+                green_mark_.mark(s);
+            }
+            ++stats_.evacuated;
+            stats_.evacuated_bytes += c->bytes;
+            return to;
+        }
+
+        void collect() {
+            sys::Timer T;
+            while (!queue_.empty()) promote_batch();   // last checkpoint's moves
+            bool major = ++since_major_ == kMajorEvery;
+            for (Cell*& slot : ring_) {
+                if (!slot) continue;
+                if (slot->forward) {
+                    slot = slot->forward;
+                    ++stats_.fixups;
+                }
+                Cell* c = slot;
+                if (red_.owns(c)) {
+                    Cell* to = evacuate(c, major);
+                    // Out of survivor space: the object dies with the
+                    // nursery; its read is lost and the checksum shows it.
+                    slot = to;
+                } else if (green_.owns(c)) {
+                    green_mark_.mark(green_.slot_index(c));
+                    if (c->age < 255) ++c->age;
+                    if (c->age >= promote_after_) queue_.push_back(c);
+                } else if (major) {
+                    blue_mark_.mark(blue_.slot_index(c));
+                }
+            }
+            stats_.swept_green += sweep(green_, green_checkpoint_, green_mark_);
+            if (major) {
+                stats_.swept_blue += sweep(blue_, blue_checkpoint_, blue_mark_);
+                since_major_ = 0;
+                ++stats_.majors;
+            }
+            red_.reset();
+            ++stats_.minors;
+            (major ? major_pauses_ : minor_pauses_).push_back(T.ms());
+        }
+
+        // dead = checkpoint AND NOT mark, over the zone's used words.
+        static std::uint64_t sweep(Zone& z, Bitfield& checkpoint, Bitfield& mark) {
+            std::uint64_t* cw = checkpoint.data();
+            std::uint64_t* mw = mark.data();
+            std::uint64_t swept = 0;
+            for (std::size_t w = 0, words = (z.slot_count() + 63) / 64; w < words; ++w) {
+                std::uint64_t dead = eval<Gate::AndNot>(cw[w], mw[w]);
+                mw[w] = 0;
+                if (!dead) continue;
+                cw[w] &= ~dead;
+                swept += popcount64(dead);
+                while (dead) {
+                    Cell* c = static_cast<Cell*>(z.slot_address(w * 64 + ctz64(dead)));
+                    z.free(c, c->bytes);
+                    dead &= dead - 1;
+                }
+            }
+            return swept;
+        }
+
+        unsigned promote_after_;
+        unsigned since_major_ = 0;
+        Zone red_, green_, blue_;
+        Bitfield green_checkpoint_, green_mark_, blue_checkpoint_, blue_mark_;
+        std::vector<Cell*> ring_;
+        std::vector<Cell*> queue_;   // Green objects due for Blue
+        std::vector<double> minor_pauses_, major_pauses_;
+        Stats stats_;
+    };
+}
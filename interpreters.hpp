@@ -0,0 +1,116 @@
+// === VGC 2.5 PPE Multi-Interpreter Isolation (One Zone Set per Context) ===
+// K interpreter-like contexts, one per pinned pool thread, sharing nothing but the machine.
+
+#pragma once
+
+#include "measure.hpp"
+#include "parallel.hpp"
+#include "topology.hpp"
+#include "workloads.hpp"
+#include "yield_memory.hpp"
+#include "zone.hpp"
+#include "zone_workloads.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace vgc {
+    // ============================================================
+    // One context per pool thread, as with one subinterpreter per core.
+    // Every context owns a ZoneSet and a Yield Memory cache on its Red
+    // zone; no allocator state, lock or cache line is shared between them,
+    // so whatever slows a context down next to the others is the machine:
+    // shared L3, memory bandwidth, SMT siblings. A call runs one script
+    // per context, timing each phase:
+    //
+    //   loop         loop_chunk(0, N)
+    //   recursion    recursive_driver(N, chunk)
+    //   temporaries  loop_with_temporaries over the Yield Memory cache
+    //   churn        mixed_lifetime over the Green zone
+    //
+    // Each phase's checksum is its closed form for N, and the call returns
+    // the sum over phases and contexts. run_solo() runs context 0's script
+    // alone on the calling thread: the no-interference reference.
+    // ============================================================
+    class InterpreterSet {
+    public:
+        enum Phase : unsigned { kLoop, kRecursion, kTemporaries, kChurn, kPhaseCount };
+
+        static const char* phase_name(unsigned ph) {
+            static const char* const names[kPhaseCount] = {"loop", "recursion", "temporaries", "churn"};
+            return ph < kPhaseCount ? names[ph] : "?";
+        }
+
+        struct Context {   // one PerThread slot each
+            double phase_ms[kPhaseCount] = {};   // summed since reset_stats()
+            std::uint64_t calls = 0;
+            short acc = 0;                       // of the last call
+        };
+
+        // `local_nodes`: commit each context's zones on the NUMA node of the
+        // CPU its thread is pinned to.
+        InterpreterSet(sys::WorkerPool& pool, std::size_t zone_bytes, sys::PageKind pages, bool local_nodes)
+            : pool_(pool), contexts_(pool.size()) {
+            for (unsigned i = 0; i < pool.size(); ++i) {
+                zones_.emplace_back(new ZoneSet(zone_bytes, pages));
+                if (local_nodes) zones_.back()->set_node(static_cast<int>(sys::topology().node_of(pool.cpu_of(i))));
+                yields_.emplace_back(new YieldCache(zones_.back()->red));
+            }
+        }
+        InterpreterSet(const InterpreterSet&) = delete;
+        InterpreterSet& operator=(const InterpreterSet&) = delete;
+
+        bool ok() const {
+            for (const auto& z : zones_)
+                if (!z->ok()) return false;
+            return true;
+        }
+        unsigned size() const { return pool_.size(); }
+        const ZoneSet& zones(unsigned index) const { return *zones_[index]; }
+
+        short run(std::size_t n, int chunk) {
+            auto body = [&](unsigned self) { script(self, n, chunk); };
+            pool_.run(body);
+            return contexts_.combine(short(0), [](short acc, const Context& c) {
+                return static_cast<short>(acc + c.acc);
+            });
+        }
+
+        short run_solo(std::size_t n, int chunk) {
+            script(0, n, chunk);
+            return contexts_[0].acc;
+        }
+
+        const sys::PerThread<Context>& contexts() const { return contexts_; }
+        void reset_stats() { contexts_.reset(); }
+
+    private:
+        void script(unsigned self, std::size_t n, int chunk) {
+            Context& c = contexts_[self];
+            ZoneSet& z = *zones_[self];
+            YieldCache& yield = *yields_[self];
+            short acc = 0;
+            sys::Timer T;
+            acc += loop_chunk(0, n);
+            c.phase_ms[kLoop] += T.ms();
+            T = sys::Timer();
+            acc += recursive_driver(n, chunk);
+            c.phase_ms[kRecursion] += T.ms();
+            T = sys::Timer();
+            acc += loop_with_temporaries(yield, n);
+            c.phase_ms[kTemporaries] += T.ms();
+            T = sys::Timer();
+            acc += mixed_lifetime(z.green, n);
+            c.phase_ms[kChurn] += T.ms();
+            ++c.calls;
+            c.acc = acc;
+        }
+
+        sys::WorkerPool& pool_;
+        std::vector<std::unique_ptr<ZoneSet>> zones_;
+        std::vector<std::unique_ptr<YieldCache>> yields_;
+        sys::PerThread<Context> contexts_;
+    };
+}
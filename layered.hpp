@@ -0,0 +1,244 @@
+// === VGC 2.5 PPE Active-Passive GC Layering (Frozen Constant Zone) ===
+// Startup constants in a read-only, never-collected zone; runtime objects in a collected one.
+
+#pragma once
+
+#include "bitfield.hpp"
+#include "measure.hpp"
+#include "zone.hpp"
+#include "zone_workloads.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vgc {
+    // ============================================================
+    // Two GC layers. Constants and code objects are loaded once at startup
+    // and never die, so marking them on every collection buys nothing:
+    //
+    //   passive  a zone of its own, filled at construction and then frozen:
+    //            read-only pages, no allocation, never marked or swept
+    //   active   the collected zone: runtime objects with checkpoint and
+    //            mark bitfields, as in collector.hpp
+    //
+    // Passive objects point only at passive objects (the layer is frozen
+    // before any runtime object exists), so it holds no roots into the
+    // active layer, and marking stops at any pointer the active zone does
+    // not own.
+    //
+    // With `layered` false the same constants go into the active zone,
+    // reachable from a root table: a single-layer heap, which re-marks them
+    // and sweeps their words on every collection.
+    //
+    // The mutator allocates N runtime objects, each pointing at a constant,
+    // into a ring of kRoots live ones, and collects every kPeriod
+    // allocations. Object i stores loop_chunk's term and is read once, when
+    // it leaves the ring, so the checksum equals loop_chunk(0, N).
+    //
+    // Incremental mode (set_slicing) keeps the mark atomic, one short pause
+    // over the roots, but sweeps in slices of at most `slots` slots or `us`
+    // microseconds, one slice every kSliceEvery allocations. Cells allocated
+    // into words the sweep has yet to reach are allocated black (marked),
+    // so the sweep keeps them; a cycle still sweeping when the next one is
+    // due finishes inside that one's mark pause. Every slice is a pause.
+    // ============================================================
+    class LayeredHeap {
+    public:
+        static constexpr std::size_t kRoots = 1u << 16;    // live runtime objects
+        static constexpr std::size_t kPeriod = 1u << 16;   // allocations between collections
+        static constexpr std::size_t kActiveBytes = std::size_t(64) << 20;
+        static constexpr std::size_t kSliceEvery = 1024;   // allocations between sweep slices
+
+        struct Cell {
+            const Cell* ref[2];    // traced; null or another cell
+            std::uint32_t bytes;   // size passed to alloc()
+            short value;
+        };
+
+        struct Stats {
+            std::uint64_t collections = 0;
+            std::uint64_t marked = 0;   // cells marked, constants included in a single layer
+            std::uint64_t swept = 0;    // cells freed
+            std::uint64_t slices = 0;   // incremental sweep steps
+        };
+
+        // `passive_pct`: the constants' share of the live heap, in bytes.
+        explicit LayeredHeap(bool layered, unsigned passive_pct = 60)
+            : layered_(layered), passive_(ZoneId::Passive, passive_capacity(passive_pct)),
+              active_(ZoneId::Green, kActiveBytes), checkpoint_(kActiveBytes / kSlotBytes),
+              mark_(kActiveBytes / kSlotBytes), ring_(kRoots, nullptr) {
+            std::size_t target = target_bytes(passive_pct);
+            Zone& home = layered_ ? passive_ : active_;
+            std::uint64_t rng = 0xA0761D6478BD642Full;
+            for (std::size_t k = 0, bytes = 0; bytes < target; ++k) {
+                std::size_t size = kSlotBytes + object_bytes(rng, 240);   // 32..256
+                Cell* c = static_cast<Cell*>(home.alloc(size));
+                if (!c) return;   // ok() stays false
+                c->ref[0] = k ? constants_[(k * 2654435761u) % k] : nullptr;
+                c->ref[1] = k ? constants_[k - 1] : nullptr;
+                c->bytes = static_cast<std::uint32_t>(size);
+                c->value = term(k);
+                if (!layered_) checkpoint_.mark(active_.slot_index(c));
+                constants_.push_back(c);
+                constant_bytes_ += size;
+                bytes += size;
+            }
+            stack_.reserve(constants_.size() + kRoots);
+            built_ = layered_ ? passive_.freeze() : true;
+        }
+        LayeredHeap(const LayeredHeap&) = delete;
+        LayeredHeap& operator=(const LayeredHeap&) = delete;
+
+        bool ok() const { return built_ && active_.ok() && checkpoint_.words() && mark_.words(); }
+        bool layered() const { return layered_; }
+
+        // 0 for both: stop-the-world. Otherwise a slice ends at whichever
+        // budget it reaches first; time is checked every 64 words.
+        void set_slicing(std::size_t slots, double us) {
+            slice_words_ = slots ? (slots + 63) / 64 : 0;
+            slice_us_ = us;
+        }
+        bool incremental() const { return slice_words_ || slice_us_ > 0; }
+        std::size_t slice_slots() const { return slice_words_ * 64; }
+        double slice_us() const { return slice_us_; }
+
+        short run(std::size_t n) {
+            // Drop the previous call's runtime objects; stats cover the
+            // mutator's collections only.
+            std::fill(ring_.begin(), ring_.end(), nullptr);
+            Stats before = stats_;
+            mark();
+            sweep(sweep_end_);
+            stats_ = before;
+            pauses_.clear();
+            pauses_.reserve(incremental() ? n / kSliceEvery + n / kPeriod : n / kPeriod);
+
+            short acc = 0;
+            std::uintptr_t seen = 0;
+            std::size_t head = 0, since = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                Cell* c = static_cast<Cell*>(active_.alloc(sizeof(Cell)));
+                if (!c) break;
+                const Cell* k = constants_[i % constants_.size()];
+                c->ref[0] = k;
+                c->ref[1] = nullptr;
+                c->bytes = static_cast<std::uint32_t>(sizeof(Cell));
+                c->value = term(i);
+                seen ^= static_cast<std::uintptr_t>(k->value);   // a read of the passive layer
+                std::size_t s = active_.slot_index(c);
+                checkpoint_.mark(s);
+                if (s / 64 >= sweep_cursor_ && s / 64 < sweep_end_) mark_.mark(s);   // allocate black
+                // The evicted root becomes garbage for the next collection.
+                Cell*& slot = ring_[head++ % kRoots];
+                if (slot) acc += slot->value;
+                slot = c;
+                if (++since == kPeriod) {
+                    sys::Timer T;
+                    mark();
+                    if (!incremental()) sweep(sweep_end_);
+                    pauses_.push_back(T.ms());
+                    ++stats_.collections;
+                    since = 0;
+                } else if (since % kSliceEvery == 0 && sweep_cursor_ < sweep_end_) {
+                    sys::Timer T;
+                    slice();
+                    pauses_.push_back(T.ms());
+                    ++stats_.slices;
+                }
+            }
+            for (Cell* c : ring_)
+                if (c) acc += c->value;
+            sys::do_not_optimize(seen);
+            return acc;
+        }
+
+        // Collection pauses of the last run(), in ms.
+        const std::vector<double>& pauses() const { return pauses_; }
+        const Stats& stats() const { return stats_; }
+        void reset_stats() { stats_ = Stats{}; }
+
+        const Zone& passive() const { return passive_; }
+        const Zone& active() const { return active_; }
+        std::size_t constants() const { return constants_.size(); }
+        std::size_t constant_bytes() const { return constant_bytes_; }
+
+    private:
+        static std::size_t runtime_bytes() { return kRoots * class_bytes(size_class(sizeof(Cell))); }
+        static std::size_t target_bytes(unsigned pct) {
+            pct = pct > 95 ? 95 : pct;
+            return runtime_bytes() / (100 - pct) * pct;
+        }
+        static std::size_t passive_capacity(unsigned pct) { return target_bytes(pct) + kMaxSmall + kCommitStep; }
+
+        void push(const Cell* c) {
+            if (!c || !active_.owns(c)) return;   // null, or the passive layer
+            std::size_t slot = active_.slot_index(c);
+            if (mark_.test(slot)) return;
+            mark_.mark(slot);
+            ++stats_.marked;
+            stack_.push_back(c);
+        }
+
+        // Finishes any sweep still running, marks, and leaves the whole used
+        // range to sweep.
+        void mark() {
+            sweep(sweep_end_);
+            if (!layered_)
+                for (const Cell* c : constants_) push(c);
+            for (const Cell* c : ring_) push(c);
+            while (!stack_.empty()) {
+                const Cell* c = stack_.back();
+                stack_.pop_back();
+                push(c->ref[0]);
+                push(c->ref[1]);
+            }
+            sweep_cursor_ = 0;
+            sweep_end_ = (active_.used_bytes() / kSlotBytes + 63) / 64;
+        }
+
+        // Sweeps words [cursor, to): dead = checkpoint AND NOT mark.
+        void sweep(std::size_t to) {
+            std::uint64_t* cw = checkpoint_.data();
+            std::uint64_t* mw = mark_.data();
+            for (std::size_t& w = sweep_cursor_; w < to; ++w) {
+                std::uint64_t dead = eval<Gate::AndNot>(cw[w], mw[w]);
+                mw[w] = 0;
+                if (!dead) continue;
+                cw[w] &= ~dead;
+                stats_.swept += popcount64(dead);
+                while (dead) {
+                    Cell* c = static_cast<Cell*>(active_.slot_address(w * 64 + ctz64(dead)));
+                    active_.free(c, c->bytes);
+                    dead &= dead - 1;
+                }
+            }
+        }
+
+        void slice() {
+            std::size_t words = slice_words_ ? slice_words_ : sweep_end_;
+            std::size_t to = sweep_end_ - sweep_cursor_ > words ? sweep_cursor_ + words : sweep_end_;
+            if (slice_us_ <= 0) return sweep(to);
+            sys::Timer T;
+            while (sweep_cursor_ < to) {
+                sweep(std::min(to, sweep_cursor_ + 64));
+                if (T.ms() * 1e3 >= slice_us_) break;
+            }
+        }
+
+        bool layered_;
+        bool built_ = false;
+        Zone passive_, active_;
+        Bitfield checkpoint_, mark_;
+        std::vector<const Cell*> constants_;
+        std::vector<Cell*> ring_;
+        std::vector<const Cell*> stack_;
+        std::vector<double> pauses_;
+        std::size_t constant_bytes_ = 0;
+        std::size_t sweep_cursor_ = 0, sweep_end_ = 0;   // words; equal once a cycle is swept
+        std::size_t slice_words_ = 0;
+        double slice_us_ = 0;
+        Stats stats_;
+    };
+}
@@ -0,0 +1,250 @@
+// === VGC 2.5 PPE Measurement Engine ===
+// Warmup, iteration calibration and repeated sampling on top of sys::Timer.
+
+#pragma once
+
+#include "counters.hpp"
+#include "sys.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sys {
+    // Force the compiler to materialize `v` (a result) or to assume it was
+    // modified (an input), so repeated calls cannot be folded or hoisted.
+    // GCC picks the first alternative even when no register is free (and
+    // then rejects the constraint), so it gets memory first.
+#if defined(__clang__)
+    template <class T>
+    inline void do_not_optimize(T& v) { asm volatile("" : "+r,m"(v) : : "memory"); }
+    template <class T>
+    inline void do_not_optimize(const T& v) { asm volatile("" : : "r,m"(v) : "memory"); }
+#elif defined(__GNUC__)
+    template <class T>
+    inline void do_not_optimize(T& v) { asm volatile("" : "+m,r"(v) : : "memory"); }
+    template <class T>
+    inline void do_not_optimize(const T& v) { asm volatile("" : : "r,m"(v) : "memory"); }
+#else
+    template <class T>
+    inline void do_not_optimize(const T& v) {
+        const volatile char* p = reinterpret_cast<const volatile char*>(&v);
+        (void)*p;
+        _ReadWriteBarrier();
+    }
+#endif
+
+    // Leak detectors for the timed region. The program bumps these: the
+    // harness's global operator new calls count_allocation(), and its
+    // console streambufs count bytes written to std::cout / std::cerr.
+    // measure() reads both around the timed samples; without those hooks
+    // they stay 0.
+    //
+    // An allocation is counted in the allocating thread's own cache line
+    // with a plain load and store, so a heap that allocates per object pays
+    // no shared read-modify-write for being counted. Each thread leases a
+    // slot on its first allocation and keeps it. Slots are not recycled;
+    // threads past kAllocSlots share the last one, which counts with
+    // fetch_add.
+    constexpr unsigned kAllocSlots = 4096;
+
+    struct alignas(64) AllocSlot {
+        std::atomic<std::uint64_t> count{0};
+    };
+    inline AllocSlot alloc_slots[kAllocSlots];
+    inline std::atomic<unsigned> alloc_threads{0};
+
+    inline void count_allocation() {
+        thread_local AllocSlot* mine = nullptr;
+        if (!mine) {
+            unsigned slot = alloc_threads.fetch_add(1, std::memory_order_relaxed);
+            mine = &alloc_slots[slot < kAllocSlots - 1 ? slot : kAllocSlots - 1];
+        }
+        if (mine == &alloc_slots[kAllocSlots - 1]) mine->count.fetch_add(1, std::memory_order_relaxed);
+        else mine->count.store(mine->count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Allocations so far, over every thread that has allocated.
+    inline std::uint64_t heap_allocations() {
+        unsigned used = alloc_threads.load(std::memory_order_relaxed);
+        used = used < kAllocSlots ? used : kAllocSlots;
+        std::uint64_t n = alloc_slots[kAllocSlots - 1].count.load(std::memory_order_relaxed);
+        for (unsigned s = 0; s < used && s < kAllocSlots - 1; ++s)
+            n += alloc_slots[s].count.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    inline std::atomic<std::uint64_t> console_bytes{0};
+
+    struct MeasureConfig {
+        int warmup = 3;              // untimed calls before calibration
+        int samples = 15;            // timed samples after calibration
+        double sample_ms = 10.0;     // calibrate iterations until one sample takes this long
+        std::size_t max_iters = std::size_t(1) << 30;
+        bool hw_counters = true;     // perf_event counters across the timed samples
+        // Counter sets of the other threads a run executes on, opened by
+        // their owner (WorkerPool::counters()); summed with the caller's.
+        std::vector<CounterSet*> thread_counters;
+    };
+
+    struct Stats {
+        double min = 0, median = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;
+        double mean = 0, stddev = 0;
+    };
+
+    struct Measurement {
+        std::vector<double> sample_ms;      // per-call time of each sample
+        std::vector<double> sample_ticks;   // per-call TSC ticks of each sample
+        std::size_t iters = 1;              // calls per sample
+        Stats stats;
+        Stats tick_stats;
+        double total_ms = 0;                // all timed samples together
+        std::uint64_t total_ticks = 0;
+        CounterReadings counters;           // totals over all timed samples
+        unsigned counter_threads = 1;       // threads those totals cover
+        short checksum = 0;                 // result of the last call
+        std::uint64_t timed_allocs = 0;     // heap_allocations during the timed samples
+        std::uint64_t timed_io_bytes = 0;   // console_bytes during the timed samples
+
+        std::size_t total_calls() const { return sample_ms.size() * iters; }
+    };
+
+    // Linear interpolation between closest ranks; `sorted` must be ascending.
+    inline double percentile(const std::vector<double>& sorted, double q) {
+        if (sorted.empty()) return 0;
+        double pos = q * static_cast<double>(sorted.size() - 1);
+        std::size_t lo = static_cast<std::size_t>(pos);
+        std::size_t hi = std::min(lo + 1, sorted.size() - 1);
+        double frac = pos - static_cast<double>(lo);
+        return sorted[lo] + (sorted[hi] - sorted[lo]) * frac;
+    }
+
+    inline Stats summarize(std::vector<double> xs) {
+        Stats s;
+        if (xs.empty()) return s;
+        std::sort(xs.begin(), xs.end());
+        s.min = xs.front();
+        s.max = xs.back();
+        s.median = percentile(xs, 0.50);
+        s.p90 = percentile(xs, 0.90);
+        s.p99 = percentile(xs, 0.99);
+        s.p999 = percentile(xs, 0.999);
+        double sum = 0;
+        for (double x : xs) sum += x;
+        s.mean = sum / static_cast<double>(xs.size());
+        double var = 0;
+        for (double x : xs) var += (x - s.mean) * (x - s.mean);
+        s.stddev = xs.size() > 1 ? std::sqrt(var / static_cast<double>(xs.size() - 1)) : 0;
+        return s;
+    }
+
+    // One-sided Mann-Whitney U test: the probability of seeing `b` rank this
+    // far above `a` if both came from one distribution. Normal approximation
+    // with tie and continuity correction; it needs 5+ samples per side to
+    // mean anything, and so returns 1 below that.
+    inline double mann_whitney_greater(const std::vector<double>& a, const std::vector<double>& b) {
+        if (a.size() < 5 || b.size() < 5) return 1.0;
+        struct Tagged {
+            double v;
+            bool from_b;
+        };
+        std::vector<Tagged> all;
+        for (double x : a) all.push_back({x, false});
+        for (double x : b) all.push_back({x, true});
+        std::sort(all.begin(), all.end(), [](const Tagged& l, const Tagged& r) { return l.v < r.v; });
+
+        double n1 = static_cast<double>(b.size()), n2 = static_cast<double>(a.size()), n = n1 + n2;
+        double rank_b = 0, ties = 0;
+        for (std::size_t i = 0; i < all.size();) {
+            std::size_t j = i;
+            while (j < all.size() && all[j].v == all[i].v) ++j;
+            double rank = (static_cast<double>(i + j) + 1) / 2;   // mean of ranks i+1..j
+            double t = static_cast<double>(j - i);
+            ties += t * t * t - t;
+            for (std::size_t k = i; k < j; ++k)
+                if (all[k].from_b) rank_b += rank;
+            i = j;
+        }
+        double u = rank_b - n1 * (n1 + 1) / 2;
+        double var = n1 * n2 / 12 * ((n + 1) - ties / (n * (n - 1)));
+        if (var <= 0) return 1.0;
+        double z = (u - n1 * n2 / 2 - 0.5) / std::sqrt(var);
+        return 0.5 * std::erfc(z / std::sqrt(2.0));
+    }
+
+    // `fn` is called as fn() and returns the workload checksum. Inputs the
+    // callable captures by reference are clobbered before every call.
+    // Everything the timed samples write goes into storage reserved before
+    // the first of them, so the harness's own recording neither allocates
+    // nor prints; timed_allocs / timed_io_bytes catch what the workload does.
+    template <class Fn>
+    Measurement measure(Fn&& fn, const MeasureConfig& cfg) {
+        Measurement m;
+        short sink = 0;
+
+        std::uint64_t ticks = 0;
+        auto batch = [&](std::size_t iters) {
+            Timer T;
+            std::uint64_t t0 = tsc_begin();
+            for (std::size_t k = 0; k < iters; ++k) {
+                do_not_optimize(fn);
+                sink = fn();
+                do_not_optimize(sink);
+            }
+            ticks = tsc_end() - t0;
+            return T.ms();
+        };
+
+        for (int k = 0; k < cfg.warmup; ++k) batch(1);
+
+        // Double the batch until it is long enough to sit well above clock
+        // resolution, then scale to the target in one step.
+        std::size_t iters = 1;
+        for (;;) {
+            double ms = batch(iters);
+            if (ms >= cfg.sample_ms || iters >= cfg.max_iters) break;
+            if (ms >= cfg.sample_ms / 8) {
+                double scaled = static_cast<double>(iters) * cfg.sample_ms / ms;
+                iters = static_cast<std::size_t>(std::ceil(scaled));
+                break;
+            }
+            iters *= 2;
+        }
+        m.iters = std::min(std::max<std::size_t>(iters, 1), cfg.max_iters);
+
+        CounterSet pmu;
+        bool use_pmu = cfg.hw_counters && pmu.open();
+
+        int n_samples = std::max(cfg.samples, 1);
+        m.sample_ms.reserve(static_cast<std::size_t>(n_samples));
+        m.sample_ticks.reserve(static_cast<std::size_t>(n_samples));
+        std::uint64_t allocs0 = heap_allocations();
+        std::uint64_t io0 = console_bytes.load(std::memory_order_relaxed);
+        if (use_pmu) {
+            for (CounterSet* t : cfg.thread_counters) t->start();
+            pmu.start();
+        }
+        for (int s = 0; s < n_samples; ++s) {
+            double ms = batch(m.iters);
+            m.total_ms += ms;
+            m.total_ticks += ticks;
+            m.sample_ms.push_back(ms / static_cast<double>(m.iters));
+            m.sample_ticks.push_back(static_cast<double>(ticks) / static_cast<double>(m.iters));
+        }
+        if (use_pmu) {
+            m.counters = pmu.stop();
+            for (CounterSet* t : cfg.thread_counters) accumulate(m.counters, t->stop());
+            m.counter_threads = 1 + static_cast<unsigned>(cfg.thread_counters.size());
+        }
+        m.timed_allocs = heap_allocations() - allocs0;
+        m.timed_io_bytes = console_bytes.load(std::memory_order_relaxed) - io0;
+
+        m.stats = summarize(m.sample_ms);
+        m.tick_stats = summarize(m.sample_ticks);
+        m.checksum = sink;
+        return m;
+    }
+}
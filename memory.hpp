@@ -0,0 +1,95 @@
+// === VGC 2.5 PPE Memory Tracking ===
+// Per-run peak RSS / page-fault deltas and an optional background RSS sampler.
+
+#pragma once
+
+#include "sys.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace sys {
+    struct MemoryReport {
+        MemorySnapshot before, after;
+        bool peak_is_per_run = false;   // false: peak is the process-lifetime high-water mark
+
+        long long rss_delta_kb() const {
+            return static_cast<long long>(after.rss_kb) - static_cast<long long>(before.rss_kb);
+        }
+        std::uint64_t minor_faults() const { return after.minor_faults - before.minor_faults; }
+        std::uint64_t major_faults() const { return after.major_faults - before.major_faults; }
+    };
+
+    struct MemoryPoint {
+        double t_ms;
+        std::size_t rss_kb;
+    };
+
+    // Samples working_set_kb() on its own thread every `interval_ms` into a
+    // buffer reserved up front, so the sampler does not allocate while the
+    // workload runs. Sampling stops silently once the buffer is full.
+    //
+    // The thread pins itself to `core` (default: the last CPU) so it does not
+    // share the workload's core. On a single-CPU host they share core 0.
+    class MemorySampler {
+    public:
+        explicit MemorySampler(double interval_ms, std::size_t capacity = 1u << 16,
+                               unsigned core = last_core())
+            : interval_(interval_ms), core_(core) {
+            points_.reserve(capacity);
+        }
+        MemorySampler(const MemorySampler&) = delete;
+        MemorySampler& operator=(const MemorySampler&) = delete;
+        ~MemorySampler() { stop(); }
+
+        void start() {
+            running_.store(true, std::memory_order_relaxed);
+            thread_ = std::thread([this] { loop(); });
+        }
+
+        void stop() {
+            running_.store(false, std::memory_order_relaxed);
+            if (thread_.joinable()) thread_.join();
+        }
+
+        // Valid after stop().
+        const std::vector<MemoryPoint>& timeline() const { return points_; }
+
+        std::size_t peak_kb() const {
+            std::size_t peak = 0;
+            for (const MemoryPoint& p : points_)
+                if (p.rss_kb > peak) peak = p.rss_kb;
+            return peak;
+        }
+
+    private:
+        static unsigned last_core() {
+            unsigned n = std::thread::hardware_concurrency();
+            return n > 1 ? n - 1 : 0;
+        }
+
+        void loop() {
+            pin_to_core_and_boost(core_);
+            Timer T;
+            auto period = std::chrono::duration<double, std::milli>(interval_);
+            auto next = Timer::Clock::now();
+            do {
+                if (points_.size() == points_.capacity()) break;
+                points_.push_back({T.ms(), working_set_kb()});
+                next += std::chrono::duration_cast<Timer::Clock::duration>(period);
+                std::this_thread::sleep_until(next);
+            } while (running_.load(std::memory_order_relaxed));
+            if (points_.size() < points_.capacity()) points_.push_back({T.ms(), working_set_kb()});
+        }
+
+        double interval_;
+        unsigned core_;
+        std::atomic<bool> running_{false};
+        std::thread thread_;
+        std::vector<MemoryPoint> points_;
+    };
+}
@@ -0,0 +1,61 @@
+// === VGC 2.5 PPE Offload Bound (Bitfield Gates Behind a Host Link) ===
+// The least time any accelerator behind a PCIe-class link needs for a bitfield sweep, against the CPU's.
+
+#pragma once
+
+#include <cstddef>
+
+namespace vgc {
+    // ============================================================
+    // A gate sweep reads two bitfields and writes one: a quarter byte per
+    // slot in, an eighth out, with one AND/ANDN per 64 slots. Offloaded,
+    // the bitfields cross the link both ways. With pinned buffers and the
+    // sweep pipelined in kChunkBytes pieces, transfers in both directions
+    // and the device's compute all overlap. The device is taken to be
+    // infinitely fast, so what remains is:
+    //
+    //   latency  launch plus the final synchronisation
+    //   + in / link     the inputs, on the link's host-to-device side
+    //   + chunk / link  the last chunk's result coming back
+    //
+    // The host still visits the set bits of the returned result, as the
+    // CPU sweep does after its gate, so that visit costs the same either
+    // way. The bound is therefore set against the CPU's gate pass alone.
+    //
+    // That is a lower bound for any device, so where the bound loses to
+    // the measured CPU gate pass, offloading loses too. Both times grow
+    // linearly in N, so there is a crossover only when the CPU needs more
+    // time per slot than the link does. While the whole result fits in one
+    // chunk it crosses the link after the inputs, and
+    //   N* = latency / (cpu per slot - (in + out) per slot / link);
+    // past kChunkBytes of output only the last chunk does, and
+    //   N* = (latency + chunk / link) / (cpu per slot - in per slot / link).
+    // ============================================================
+    struct OffloadBound {
+        static constexpr std::size_t kChunkBytes = std::size_t(4) << 20;
+        static constexpr double kInBytesPerSlot = 2.0 / 8;   // checkpoint and mark
+        static constexpr double kOutBytesPerSlot = 1.0 / 8;
+
+        double link_gbps = 25;     // PCIe 4.0 x16, per direction
+        double latency_us = 10;
+
+        double link_ns_per_slot() const { return kInBytesPerSlot / link_gbps; }
+
+        double ms(std::size_t slots) const {
+            double out = kOutBytesPerSlot * static_cast<double>(slots);
+            double tail = out < static_cast<double>(kChunkBytes) ? out : static_cast<double>(kChunkBytes);
+            return latency_us * 1e-3 + (link_ns_per_slot() * static_cast<double>(slots) + tail / link_gbps) * 1e-6;
+        }
+
+        // Slots above which the bound beats a CPU sweep at `cpu_ns_per_slot`
+        // (where ms() crosses it); 0 for never.
+        double crossover(double cpu_ns_per_slot) const {
+            double gain = cpu_ns_per_slot - link_ns_per_slot();
+            if (gain <= 0) return 0;
+            double one_chunk = gain - kOutBytesPerSlot / link_gbps;
+            double chunk_slots = static_cast<double>(kChunkBytes) / kOutBytesPerSlot;
+            if (one_chunk > 0 && latency_us * 1e3 / one_chunk <= chunk_slots) return latency_us * 1e3 / one_chunk;
+            return (latency_us * 1e3 + static_cast<double>(kChunkBytes) / link_gbps) / gain;
+        }
+    };
+}
@@ -0,0 +1,313 @@
+// === VGC 2.5 PPE Partitioned Loop Engine (Multi-Core, Short Checksum) ===
+// Persistent pinned worker pool plus loop_chunk split across partitions.
+
+#pragma once
+
+#include "counters.hpp"
+#include "sys.hpp"
+#include "workloads.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace sys {
+    // Padding unit between data written by different threads. The library
+    // constant where the toolchain has it (GCC takes it from -mtune, and so
+    // warns that it is not ABI-stable; it does not cross a library
+    // boundary here), 64 otherwise.
+#if defined(__cpp_lib_hardware_interference_size)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+    constexpr std::size_t kCacheLine = std::hardware_destructive_interference_size;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#else
+    constexpr std::size_t kCacheLine = 64;
+#endif
+
+    inline void cpu_relax() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    // Spin briefly, then yield, so an oversubscribed host still makes progress.
+    template <class Pred>
+    inline void spin_until(Pred&& done) {
+        for (unsigned k = 0; !done(); ++k) {
+            if (k < 4096) cpu_relax();
+            else std::this_thread::yield();
+        }
+    }
+
+    // Test-and-test-and-set lock for short critical sections; waiters spin on
+    // a plain load so the line stays shared until the holder releases it.
+    class SpinLock {
+    public:
+        void lock() {
+            while (flag_.exchange(true, std::memory_order_acquire))
+                spin_until([this] { return !flag_.load(std::memory_order_relaxed); });
+        }
+        bool try_lock() { return !flag_.exchange(true, std::memory_order_acquire); }
+        void unlock() { flag_.store(false, std::memory_order_release); }
+
+    private:
+        std::atomic<bool> flag_{false};
+    };
+
+    // Reusable barrier for the threads of one dispatch. The last thread to
+    // arrive rearms the count before it bumps the generation, so a thread
+    // that races ahead into the next wait() always counts toward that one.
+    class SpinBarrier {
+    public:
+        explicit SpinBarrier(unsigned count = 1) : count_(count) {}
+
+        // Not thread-safe; call between dispatches.
+        void reset(unsigned count) {
+            count_ = count;
+            arrived_.store(0, std::memory_order_relaxed);
+        }
+
+        void wait() {
+            std::uint64_t gen = generation_.load(std::memory_order_acquire);
+            if (arrived_.fetch_add(1, std::memory_order_acq_rel) + 1 == count_) {
+                arrived_.store(0, std::memory_order_relaxed);
+                generation_.fetch_add(1, std::memory_order_release);
+                return;
+            }
+            spin_until([&] { return generation_.load(std::memory_order_acquire) != gen; });
+        }
+
+    private:
+        unsigned count_;
+        alignas(kCacheLine) std::atomic<unsigned> arrived_{0};
+        alignas(kCacheLine) std::atomic<std::uint64_t> generation_{0};
+    };
+
+    // ============================================================
+    // PerThread<T>: one T per pool thread, each in its own cache-line-aligned
+    // slot, so a thread updating its slot never invalidates a neighbour's.
+    // Sized at construction, outside any timed region; nothing in it
+    // allocates afterwards. combine() folds the slots on the calling thread
+    // once WorkerPool::run() has returned, whose completion handshake
+    // (release/acquire on the pending count) already publishes every slot,
+    // so the fold needs neither a lock nor atomics.
+    // ============================================================
+    template <class T>
+    class PerThread {
+    public:
+        explicit PerThread(unsigned threads) : slots_(threads ? threads : 1) {}
+
+        unsigned size() const { return static_cast<unsigned>(slots_.size()); }
+        T& operator[](unsigned index) { return slots_[index].value; }
+        const T& operator[](unsigned index) const { return slots_[index].value; }
+
+        void reset() {
+            for (Slot& s : slots_) s.value = T{};
+        }
+
+        // fold(acc, slot) over the slots in thread order.
+        template <class Acc, class Fold>
+        Acc combine(Acc acc, Fold fold) const {
+            for (const Slot& s : slots_) acc = fold(acc, s.value);
+            return acc;
+        }
+
+    private:
+        struct alignas(kCacheLine) Slot {
+            T value{};
+        };
+        std::vector<Slot> slots_;
+    };
+
+    inline unsigned cpu_count() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+
+    // ============================================================
+    // Worker pool: thread 0 is the caller, threads 1..T-1 are workers.
+    // Thread i is pinned on cpus[i], a placement from topology.hpp; without
+    // one, thread i runs on CPU i, wrapping on oversubscription. The caller
+    // is repinned and boosted too and stays so after the pool is gone. The
+    // workers would inherit that boost, so each one pins itself and drops
+    // back to normal priority before its first dispatch. Threads stay alive
+    // across dispatches so the measured time excludes thread creation.
+    //
+    // An idle worker spins for kSpinBeforePark pauses, which covers the gap
+    // between back-to-back dispatches in a timed sample, and then parks on
+    // a condition variable. Between samples and during the serial-reference
+    // and reporting passes the workers therefore sleep instead of taking
+    // the other cores (and thread 0's SMT sibling) from what is measured.
+    //
+    // counters() opens one CounterSet per worker, once, for measure() to
+    // sum with the caller's, so per-call PMU figures cover the whole pool.
+    // ============================================================
+    class WorkerPool {
+    public:
+        explicit WorkerPool(unsigned threads, std::vector<unsigned> cpus = {})
+            : busy_ms_(threads), cpus_(std::move(cpus)) {
+            if (cpus_.empty())
+                for (unsigned i = 0; i < size(); ++i) cpus_.push_back(i % cpu_count());
+            pin_to_core_and_boost(cpu_of(0));
+            for (unsigned i = 1; i < size(); ++i)
+                threads_.emplace_back([this, i] { worker(i); });
+            spin_until([this] { return started_.load(std::memory_order_acquire) == size() - 1; });
+        }
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+        ~WorkerPool() {
+            stop_.store(true, std::memory_order_relaxed);
+            publish();
+            for (std::thread& t : threads_) t.join();
+        }
+
+        unsigned size() const { return busy_ms_.size(); }
+        unsigned cpu_of(unsigned index) const { return cpus_[index % cpus_.size()]; }
+
+        // Runs fn(index) on every thread and returns when all have finished.
+        template <class Fn>
+        void run(Fn& fn) {
+            ctx_ = &fn;
+            invoke_ = [](void* ctx, unsigned i) { (*static_cast<Fn*>(ctx))(i); };
+            pending_.store(size() - 1, std::memory_order_relaxed);
+            publish();
+            execute(0);
+            spin_until([this] { return pending_.load(std::memory_order_acquire) == 0; });
+            ++dispatches_;
+        }
+
+        // Counter sets of threads 1..T-1, opened on first use.
+        const std::vector<CounterSet*>& counters() {
+            if (counter_ptrs_.empty())
+                for (unsigned i = 1; i < size(); ++i) {
+                    counter_sets_.emplace_back(new CounterSet);
+                    counter_sets_.back()->open(thread_ids_[i]);
+                    counter_ptrs_.push_back(counter_sets_.back().get());
+                }
+            return counter_ptrs_;
+        }
+
+        // Summed per-thread busy time since the last reset_stats().
+        double busy_ms(unsigned index) const { return busy_ms_[index]; }
+        std::size_t dispatches() const { return dispatches_; }
+        void reset_stats() {
+            busy_ms_.reset();
+            dispatches_ = 0;
+        }
+
+    private:
+        static constexpr unsigned kSpinBeforePark = 1u << 14;
+
+        // The generation bump and the parked_ load are sequentially
+        // consistent, as are park()'s parked_ increment and generation
+        // load: either publish() sees the parked worker and wakes it under
+        // the mutex, or the worker sees the new generation before it waits.
+        void publish() {
+            generation_.fetch_add(1);
+            if (parked_.load()) {
+                std::lock_guard<std::mutex> lock(park_mutex_);
+                park_cv_.notify_all();
+            }
+        }
+
+        void wait_for_dispatch(std::uint64_t seen) {
+            for (unsigned k = 0; k < kSpinBeforePark; ++k) {
+                if (generation_.load(std::memory_order_acquire) != seen) return;
+                cpu_relax();
+            }
+            std::unique_lock<std::mutex> lock(park_mutex_);
+            parked_.fetch_add(1);
+            park_cv_.wait(lock, [&] { return generation_.load() != seen; });
+            parked_.fetch_sub(1);
+        }
+
+        void execute(unsigned i) {
+            Timer T;
+            invoke_(ctx_, i);
+            busy_ms_[i] += T.ms();
+        }
+
+        void worker(unsigned i) {
+            pin_to_core(cpu_of(i));
+            drop_boost();
+            thread_ids_[i] = counter_thread_id();
+            started_.fetch_add(1, std::memory_order_release);
+            std::uint64_t seen = 0;
+            for (;;) {
+                wait_for_dispatch(seen);
+                seen = generation_.load(std::memory_order_acquire);
+                if (stop_.load(std::memory_order_relaxed)) return;
+                execute(i);
+                pending_.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        PerThread<double> busy_ms_;
+        PerThread<long> thread_ids_{busy_ms_.size()};
+        std::vector<std::unique_ptr<CounterSet>> counter_sets_;
+        std::vector<CounterSet*> counter_ptrs_;
+        std::vector<unsigned> cpus_;
+        std::vector<std::thread> threads_;
+        void* ctx_ = nullptr;
+        void (*invoke_)(void*, unsigned) = nullptr;
+        alignas(kCacheLine) std::atomic<std::uint64_t> generation_{0};
+        alignas(kCacheLine) std::atomic<unsigned> pending_{0};
+        std::atomic<unsigned> parked_{0};
+        std::mutex park_mutex_;
+        std::condition_variable park_cv_;
+        std::atomic<bool> stop_{false};
+        std::atomic<unsigned> started_{0};
+        std::size_t dispatches_ = 0;
+    };
+}
+
+// ============================================================
+// Multi-core loop: [0, n) split into contiguous partitions, one per pool
+// thread. short addition wraps mod 2^16, so summing the partition shorts
+// gives the same checksum as loop_chunk(0, n). `partials` needs a slot per
+// pool thread and is reused across calls, so a call does not allocate.
+// partitioned_range() takes the partition body, `short range(begin, end)`,
+// as a template argument, so it is inlined into the pool's one call per
+// thread.
+// ============================================================
+inline std::size_t partition_begin(std::size_t n, unsigned parts, unsigned index) {
+    return static_cast<std::size_t>(
+        static_cast<unsigned long long>(n) / parts * index +
+        static_cast<unsigned long long>(n) % parts * index / parts);
+}
+
+template <class Body>
+inline short partitioned_range(sys::WorkerPool& pool, sys::PerThread<short>& partials, std::size_t n, Body&& range) {
+    const unsigned parts = pool.size();
+    auto body = [&](unsigned i) {
+        partials[i] = range(partition_begin(n, parts, i), partition_begin(n, parts, i + 1));
+    };
+    pool.run(body);
+    return partials.combine(short(0), [](short acc, short p) { return static_cast<short>(acc + p); });
+}
+
+inline short partitioned_loop(sys::WorkerPool& pool, sys::PerThread<short>& partials, std::size_t n) {
+    return partitioned_range(pool, partials, n, [](std::size_t begin, std::size_t end) {
+        return loop_chunk(begin, end);
+    });
+}
@@ -0,0 +1,180 @@
+// === VGC 2.5 PPE Regression Tracking (Stored Baselines, Significance Tests) ===
+// Saves run records per host and workload, and checks later runs against them.
+
+#pragma once
+
+#include "measure.hpp"
+#include "report.hpp"
+
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace report {
+    // ============================================================
+    // A baseline is the JSON-lines file of run records that a `save` pass
+    // writes to <dir>/<host>_<workload>.jsonl. A `check` pass looks up the
+    // record with the same configuration (N, chunk, threads, variant, gate).
+    // The result itself must not change at all:
+    //
+    //   checksum      equal to the baseline record's
+    //   oracle        still "match" where the run has a closed form
+    //
+    // and three metrics each have to grow by more than `threshold_pct` to
+    // count:
+    //
+    //   time          per-call samples, and the slowdown must also be
+    //                 significant by a one-sided Mann-Whitney U test at `alpha`
+    //   instructions  per call, PMU total / calls. Nearly deterministic,
+    //                 so the threshold alone decides. Compared only when
+    //                 both records count the same threads (records without
+    //                 counter_threads counted one)
+    //   peak RSS      one value per run. It must also grow by at least
+    //                 kRssFloorKb, below which allocator noise dominates
+    // ============================================================
+    enum class BaselineMode : unsigned char { Off, Save, Check };
+
+    struct Verdict {
+        const char* metric;
+        const char* unit;
+        double before, after;
+        double change_pct;
+        double p;          // time only; 1 elsewhere
+        bool regressed;
+        bool exact;        // checksum, oracle: compared as text, no percentage
+        std::string before_text, after_text;
+    };
+
+    class Baselines {
+    public:
+        static constexpr double kRssFloorKb = 1024;
+
+        Baselines() = default;
+        Baselines(BaselineMode mode, std::string dir, double threshold_pct, double alpha)
+            : mode_(mode), dir_(std::move(dir)), threshold_pct_(threshold_pct), alpha_(alpha) {}
+
+        BaselineMode mode() const { return mode_; }
+        bool active() const { return mode_ != BaselineMode::Off; }
+        const std::string& dir() const { return dir_; }
+
+        std::string path_for(const Record& r) const {
+            std::string host = r.text("host");
+            for (char& c : host)
+                if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-') c = '_';
+            return dir_ + "/" + (host.empty() ? "host" : host) + "_" + r.text("workload") + ".jsonl";
+        }
+
+        // The first record for a file in this process replaces the file, so
+        // one save pass leaves exactly the configurations it ran.
+        bool save(const Record& r) {
+            std::error_code ec;
+            std::filesystem::create_directories(dir_, ec);
+            std::string path = path_for(r);
+            bool first = written_.insert(path).second;
+            std::ofstream f(path, first ? std::ios::trunc : std::ios::app);
+            if (!f) return false;
+            f << to_json(r) << "\n";
+            return static_cast<bool>(f);
+        }
+
+        // Empty when no baseline record matches. Counts towards compared()
+        // and regressions() otherwise.
+        std::vector<Verdict> check(const Record& r) {
+            std::vector<Verdict> out;
+            const Record* base = find(r);
+            if (!base) {
+                ++missing_;
+                return out;
+            }
+            ++compared_;
+
+            std::string bc = base->text("checksum"), ac = r.text("checksum");
+            if (!bc.empty() && !ac.empty()) out.push_back(same("checksum", bc, ac, bc != ac));
+            std::string bo = base->text("oracle"), ao = r.text("oracle");
+            if (!ao.empty()) out.push_back(same("oracle", bo.empty() ? "none" : bo, ao, ao != "match"));
+
+            std::vector<double> before = base->numbers("sample_ms"), after = r.numbers("sample_ms");
+            if (!before.empty() && !after.empty()) {
+                double b = base->number("median_ms"), a = r.number("median_ms");
+                double p = sys::mann_whitney_greater(before, after);
+                out.push_back(judge("time", "ms", b, a, p, [&](double pct) {
+                    return pct > threshold_pct_ && p < alpha_;
+                }));
+            }
+            double bi = base->number("instructions") / base->number("calls");
+            double ai = r.number("instructions") / r.number("calls");
+            double bt = base->number("counter_threads"), at = r.number("counter_threads");
+            bool same_threads = (std::isfinite(bt) ? bt : 1) == (std::isfinite(at) ? at : 1);
+            if (std::isfinite(bi) && std::isfinite(ai) && same_threads)
+                out.push_back(judge("instructions", "/call", bi, ai, 1.0, [&](double pct) { return pct > threshold_pct_; }));
+            double br = base->number("peak_rss_kb"), ar = r.number("peak_rss_kb");
+            if (std::isfinite(br) && std::isfinite(ar))
+                out.push_back(judge("peak RSS", "KB", br, ar, 1.0, [&](double pct) {
+                    return pct > threshold_pct_ && ar - br >= kRssFloorKb;
+                }));
+
+            for (const Verdict& v : out)
+                if (v.regressed) {
+                    ++regressions_;
+                    break;
+                }
+            return out;
+        }
+
+        std::size_t compared() const { return compared_; }
+        std::size_t missing() const { return missing_; }
+        std::size_t regressions() const { return regressions_; }   // runs with at least one regressed metric
+        double threshold_pct() const { return threshold_pct_; }
+        double alpha() const { return alpha_; }
+
+    private:
+        template <class Regressed>
+        static Verdict judge(const char* metric, const char* unit, double before, double after, double p,
+                             Regressed regressed) {
+            double pct = before > 0 ? 100.0 * (after - before) / before : 0.0;
+            return Verdict{metric, unit, before, after, pct, p, regressed(pct), false, "", ""};
+        }
+
+        static Verdict same(const char* metric, const std::string& before, const std::string& after,
+                            bool regressed) {
+            return Verdict{metric, "", 0, 0, 0, 1.0, regressed, true, before, after};
+        }
+
+        const Record* find(const Record& r) {
+            std::string path = path_for(r);
+            auto it = loaded_.find(path);
+            if (it == loaded_.end()) {
+                std::vector<Record> recs;
+                std::ifstream f(path);
+                for (std::string line; std::getline(f, line);) {
+                    Record rec;
+                    if (parse_json(line, rec)) recs.push_back(std::move(rec));
+                }
+                it = loaded_.emplace(path, std::move(recs)).first;
+            }
+            static const char* const keys[] = {"workload", "n", "chunk", "threads", "variant", "gate"};
+            const Record* hit = nullptr;   // the last match wins, as in an appended file
+            for (const Record& b : it->second) {
+                bool same = true;
+                for (const char* k : keys) same = same && b.text(k) == r.text(k);
+                if (same) hit = &b;
+            }
+            return hit;
+        }
+
+        BaselineMode mode_ = BaselineMode::Off;
+        std::string dir_;
+        double threshold_pct_ = 5.0;
+        double alpha_ = 0.01;
+        std::set<std::string> written_;
+        std::map<std::string, std::vector<Record>> loaded_;
+        std::size_t compared_ = 0, missing_ = 0, regressions_ = 0;
+    };
+}
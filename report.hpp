@@ -0,0 +1,339 @@
+// === VGC 2.5 PPE Machine-Readable Results (JSON Lines, CSV) ===
+// One flat record per run, carrying the build and host it ran on.
+
+#pragma once
+
+#include "sys.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <type_traits>
+#include <vector>
+
+namespace report {
+    // ============================================================
+    // Build description. VGC_BUILD_FLAGS, if the build defines it, is the
+    // exact command line; the compile lines in README.md pass it. Otherwise
+    // the flags are reconstructed from the predefined macros: target ISA,
+    // sanitizers, -O0 and -Os, but not which of -O1..-O3 was used, since
+    // __OPTIMIZE__ is the same for all three. That shows as "-O?".
+    // ============================================================
+    inline std::string compiler() {
+#if defined(__clang__)
+        return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+        return std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+        return "unknown";
+#endif
+    }
+
+    inline std::string build_flags() {
+#if defined(VGC_BUILD_FLAGS)
+        return VGC_BUILD_FLAGS;
+#else
+        std::string f = "-std=c++" + std::to_string(__cplusplus / 100 % 100);
+        std::string note = " (derived)";
+#if defined(__OPTIMIZE_SIZE__)
+        f += " -Os";
+#elif defined(__OPTIMIZE__)
+        f += " -O?";
+        note = " (derived, optimization level unknown)";
+#elif defined(__GNUC__)
+        f += " -O0";
+#endif
+#if defined(NDEBUG)
+        f += " -DNDEBUG";
+#endif
+#if defined(__AVX512F__)
+        f += " -mavx512f";
+#elif defined(__AVX2__)
+        f += " -mavx2";
+#endif
+#if defined(__SANITIZE_ADDRESS__)
+        f += " -fsanitize=address";
+#endif
+#if defined(__SANITIZE_THREAD__)
+        f += " -fsanitize=thread";
+#endif
+        return f + note;
+#endif
+    }
+
+    inline std::string utc_timestamp() {
+        std::time_t t = std::time(nullptr);
+        char buf[32] = {};
+        if (const std::tm* tm = std::gmtime(&t)) std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", tm);
+        return buf;
+    }
+
+    // ============================================================
+    // Record: ordered key/value fields. Numbers are formatted when added,
+    // so both writers emit identical text. Non-finite numbers become null.
+    // ============================================================
+    class Record {
+    public:
+        enum Kind : unsigned char { kString, kNumber, kArray, kNull };
+
+        struct Field {
+            std::string key;
+            Kind kind;
+            std::string text;                // kString, kNumber
+            std::vector<std::string> items;  // kArray, already formatted
+        };
+
+        Record& str(const char* key, const std::string& v) { return push(key, kString, v); }
+        Record& num(const char* key, double v) { return std::isfinite(v) ? push(key, kNumber, format(v)) : null(key); }
+        template <class T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        Record& num(const char* key, T v) { return push(key, kNumber, std::to_string(v)); }
+        Record& flag(const char* key, bool v) { return push(key, kNumber, v ? "true" : "false"); }
+        Record& null(const char* key) { return push(key, kNull, ""); }
+        Record& array(const char* key, const std::vector<double>& v) {
+            push(key, kArray, "");
+            for (double x : v) fields_.back().items.push_back(std::isfinite(x) ? format(x) : "null");
+            return *this;
+        }
+
+        Record& field(Field f) {
+            fields_.push_back(std::move(f));
+            return *this;
+        }
+
+        const std::vector<Field>& fields() const { return fields_; }
+
+        const Field* find(const char* key) const {
+            for (const Field& f : fields_)
+                if (f.key == key) return &f;
+            return nullptr;
+        }
+        // NaN when the key is missing, null or not a number.
+        double number(const char* key) const {
+            const Field* f = find(key);
+            if (!f || f->kind != kNumber) return std::nan("");
+            char* end = nullptr;
+            double v = std::strtod(f->text.c_str(), &end);
+            return end == f->text.c_str() ? std::nan("") : v;
+        }
+        std::vector<double> numbers(const char* key) const {
+            std::vector<double> v;
+            if (const Field* f = find(key))
+                for (const std::string& x : f->items) v.push_back(std::strtod(x.c_str(), nullptr));
+            return v;
+        }
+        // The value as written: a string's contents, a number's text, "" for null.
+        std::string text(const char* key) const {
+            const Field* f = find(key);
+            return f ? f->text : "";
+        }
+
+    private:
+        Record& push(const char* key, Kind k, const std::string& text) {
+            fields_.push_back(Field{key, k, text, {}});
+            return *this;
+        }
+
+        // Shortest form that round-trips a double.
+        static std::string format(double v) {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.17g", v);
+            for (int p = 6; p < 17; ++p) {
+                char shortest[32];
+                std::snprintf(shortest, sizeof(shortest), "%.*g", p, v);
+                if (std::strtod(shortest, nullptr) == v) return shortest;
+            }
+            return buf;
+        }
+
+        std::vector<Field> fields_;
+    };
+
+    // Build, host and time of this process; the first fields of every record.
+    inline Record host_record() {
+        Record r;
+        r.num("schema", 1)
+            .str("vgc", "2.5")
+            .str("timestamp", utc_timestamp())
+            .str("host", sys::host_name())
+            .str("platform", sys::platform_name())
+            .str("cpu_model", sys::cpu_model())
+            .num("cpus", std::thread::hardware_concurrency())
+            .str("governor", sys::cpu_governor())
+            .str("compiler", compiler())
+            .str("flags", build_flags());
+        return r;
+    }
+
+    // ============================================================
+    // Writers. JSON lines: one object per record. CSV: a header from the
+    // first record's keys, then one row per record; arrays go into one
+    // field, ';'-separated. Records written to one CSV must share keys.
+    // ============================================================
+    inline std::string json_escape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            switch (c) {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char buf[8];
+                        std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                        out += buf;
+                    } else {
+                        out += c;
+                    }
+            }
+        }
+        return out;
+    }
+
+    inline std::string to_json(const Record& r) {
+        std::string s = "{";
+        for (const Record::Field& f : r.fields()) {
+            if (s.size() > 1) s += ",";
+            s += "\"" + json_escape(f.key) + "\":";
+            switch (f.kind) {
+                case Record::kString: s += "\"" + json_escape(f.text) + "\""; break;
+                case Record::kNumber: s += f.text; break;
+                case Record::kNull:   s += "null"; break;
+                case Record::kArray:
+                    s += "[";
+                    for (std::size_t k = 0; k < f.items.size(); ++k) s += (k ? "," : "") + f.items[k];
+                    s += "]";
+                    break;
+            }
+        }
+        return s + "}";
+    }
+
+    // Reads back what to_json() writes: one flat object whose values are
+    // strings, numbers, true/false, null or arrays of numbers. Returns
+    // false on anything else.
+    inline bool parse_json(const std::string& s, Record& out) {
+        std::size_t i = 0;
+        auto ws = [&] {
+            while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r' || s[i] == '\n')) ++i;
+        };
+        auto string = [&](std::string& v) {
+            if (i >= s.size() || s[i] != '"') return false;
+            for (++i; i < s.size() && s[i] != '"'; ++i) {
+                char c = s[i];
+                if (c == '\\' && i + 1 < s.size()) {
+                    c = s[++i];
+                    if (c == 'n') c = '\n';
+                    else if (c == 't') c = '\t';
+                    else if (c == 'u' && i + 4 < s.size()) {
+                        c = static_cast<char>(std::strtol(s.substr(i + 1, 4).c_str(), nullptr, 16));
+                        i += 4;
+                    }
+                }
+                v += c;
+            }
+            return i++ < s.size();
+        };
+        auto scalar = [&](std::string& v) {
+            std::size_t b = i;
+            while (i < s.size() && s[i] != ',' && s[i] != ']' && s[i] != '}' && s[i] != ' ') ++i;
+            v = s.substr(b, i - b);
+            return !v.empty();
+        };
+
+        ws();
+        if (i >= s.size() || s[i++] != '{') return false;
+        for (ws(); i < s.size() && s[i] != '}';) {
+            Record::Field f{"", Record::kNull, "", {}};
+            if (!string(f.key)) return false;
+            ws();
+            if (i >= s.size() || s[i++] != ':') return false;
+            ws();
+            if (i < s.size() && s[i] == '"') {
+                f.kind = Record::kString;
+                if (!string(f.text)) return false;
+            } else if (i < s.size() && s[i] == '[') {
+                f.kind = Record::kArray;
+                for (++i, ws(); i < s.size() && s[i] != ']';) {
+                    std::string x;
+                    if (!scalar(x)) return false;
+                    f.items.push_back(x);
+                    ws();
+                    if (i < s.size() && s[i] == ',') ++i;
+                    ws();
+                }
+                if (i++ >= s.size()) return false;
+            } else {
+                if (!scalar(f.text)) return false;
+                if (f.text == "null") f.text.clear();
+                else f.kind = Record::kNumber;
+            }
+            out.field(std::move(f));
+            ws();
+            if (i < s.size() && s[i] == ',') ++i;
+            ws();
+        }
+        return i < s.size();
+    }
+
+    inline std::string csv_quote(const std::string& s) {
+        if (s.find_first_of(",\"\n") == std::string::npos) return s;
+        std::string out = "\"";
+        for (char c : s) out += c == '"' ? std::string("\"\"") : std::string(1, c);
+        return out + "\"";
+    }
+
+    class Writer {
+    public:
+        // Appends to `path`; returns false if it cannot be opened.
+        bool open_json(const std::string& path) {
+            json_.open(path, std::ios::app);
+            return json_.is_open();
+        }
+        // Truncates `path`, since a second header would break the file.
+        bool open_csv(const std::string& path) {
+            csv_.open(path, std::ios::trunc);
+            return csv_.is_open();
+        }
+
+        bool active() const { return json_.is_open() || csv_.is_open(); }
+
+        void write(const Record& r) {
+            if (json_.is_open()) json_ << to_json(r) << "\n" << std::flush;
+            if (!csv_.is_open()) return;
+            if (!csv_header_) {
+                std::string h;
+                for (const Record::Field& f : r.fields()) h += (h.empty() ? "" : ",") + csv_quote(f.key);
+                csv_ << h << "\n";
+                csv_header_ = true;
+            }
+            std::string row;
+            bool first = true;
+            for (const Record::Field& f : r.fields()) {
+                if (!first) row += ",";
+                first = false;
+                if (f.kind == Record::kArray) {
+                    std::string joined;
+                    for (std::size_t k = 0; k < f.items.size(); ++k) joined += (k ? ";" : "") + f.items[k];
+                    row += joined;
+                } else {
+                    row += csv_quote(f.text);
+                }
+            }
+            csv_ << row << "\n" << std::flush;
+        }
+
+    private:
+        std::ofstream json_, csv_;
+        bool csv_header_ = false;
+    };
+}
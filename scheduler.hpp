@@ -0,0 +1,227 @@
+// === VGC 2.5 PPE Work-Stealing Scheduler (Chase-Lev Deques, Steal-Half) ===
+// Distributes recursive_driver's independent chunks across the worker pool.
+
+#pragma once
+
+#include "parallel.hpp"
+#include "workloads.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace sys {
+    // ============================================================
+    // Fixed-capacity Chase-Lev deque (Le et al., "Correct and Efficient
+    // Work-Stealing for Weak Memory Models", 2013). The owner pushes and
+    // pops at the bottom; thieves take from the top. Slots are atomics so
+    // a thief reading a slot the owner is rewriting is not a data race.
+    // ============================================================
+    template <class T>
+    class ChaseLevDeque {
+    public:
+        explicit ChaseLevDeque(std::size_t capacity = 0) { reserve(capacity); }
+        ChaseLevDeque(const ChaseLevDeque&) = delete;
+        ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+        // Not thread-safe; call between runs.
+        void reserve(std::size_t capacity) {
+            std::size_t cap = 1;
+            while (cap < capacity) cap <<= 1;
+            if (cap != mask_ + 1 || !buf_) {
+                buf_.reset(new std::atomic<T>[cap]);
+                mask_ = cap - 1;
+            }
+            top_.store(0, std::memory_order_relaxed);
+            bottom_.store(0, std::memory_order_relaxed);
+        }
+
+        std::size_t capacity() const { return mask_ + 1; }
+
+        std::int64_t size_approx() const {
+            std::int64_t n = bottom_.load(std::memory_order_relaxed) - top_.load(std::memory_order_relaxed);
+            return n > 0 ? n : 0;
+        }
+
+        // Owner only. Returns false when full.
+        bool push(T v) {
+            std::int64_t b = bottom_.load(std::memory_order_relaxed);
+            std::int64_t t = top_.load(std::memory_order_acquire);
+            if (b - t > static_cast<std::int64_t>(mask_)) return false;
+            buf_[static_cast<std::size_t>(b) & mask_].store(v, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Owner only.
+        bool pop(T& out) {
+            std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+            bottom_.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t t = top_.load(std::memory_order_relaxed);
+            if (t > b) {
+                bottom_.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+            out = buf_[static_cast<std::size_t>(b) & mask_].load(std::memory_order_relaxed);
+            if (t == b) {
+                // Last element: race the thieves for it.
+                bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                        std::memory_order_relaxed);
+                bottom_.store(b + 1, std::memory_order_relaxed);
+                return won;
+            }
+            return true;
+        }
+
+        // Any thread.
+        bool steal(T& out) {
+            std::int64_t t = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t b = bottom_.load(std::memory_order_acquire);
+            if (t >= b) return false;
+            out = buf_[static_cast<std::size_t>(t) & mask_].load(std::memory_order_relaxed);
+            return top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                std::memory_order_relaxed);
+        }
+
+    private:
+        std::unique_ptr<std::atomic<T>[]> buf_;
+        std::size_t mask_ = 0;
+        alignas(kCacheLine) std::atomic<std::int64_t> top_{0};
+        alignas(kCacheLine) std::atomic<std::int64_t> bottom_{0};
+    };
+
+    // ============================================================
+    // Chunk scheduler: one deque per pool thread, seeded with that thread's
+    // contiguous slice of chunk ids. Idle threads pick victims starting at a
+    // random offset and steal half of the victim's remaining chunks.
+    // run_chunks() executes `short chunk_body(id)` per chunk, a template
+    // argument inlined into the worker loop; run_recursive() is one such
+    // body.
+    // ============================================================
+    class ChunkScheduler {
+    public:
+        struct ThreadStats {   // one PerThread slot each
+            std::uint64_t chunks = 0;          // chunks executed
+            std::uint64_t steal_attempts = 0;  // victims probed
+            std::uint64_t steals = 0;          // successful steal-half batches
+            std::uint64_t stolen = 0;          // chunks moved by those batches
+            short acc = 0;
+        };
+
+        explicit ChunkScheduler(WorkerPool& pool) : pool_(pool), deques_(pool.size()), stats_(pool.size()) {}
+
+        WorkerPool& pool() { return pool_; }
+        const PerThread<ThreadStats>& stats() const { return stats_; }
+
+        // Same result as recursive_driver(total_steps, chunk_size).
+        short run_recursive(std::size_t total_steps, int chunk_size) {
+            const std::size_t step = static_cast<std::size_t>(chunk_size);
+            return run_chunks((total_steps + step - 1) / step, [chunk_size](std::uint64_t) {
+                return recursive_chunk(0, chunk_size, 0);
+            });
+        }
+
+        // Sum of chunk_body(c) over chunk ids [0, chunks), in any order.
+        template <class Body>
+        short run_chunks(std::size_t chunks, Body chunk_body) {
+            const unsigned parts = pool_.size();
+            for (unsigned i = 0; i < parts; ++i) {
+                std::size_t lo = partition_begin(chunks, parts, i), hi = partition_begin(chunks, parts, i + 1);
+                deques_[i].reserve(hi - lo + 1);
+                stats_[i].acc = 0;
+            }
+            remaining_.store(chunks, std::memory_order_relaxed);
+
+            auto body = [&](unsigned self) {
+                // Seed on the owning thread so the deque pages are first-touched there.
+                std::size_t lo = partition_begin(chunks, parts, self), hi = partition_begin(chunks, parts, self + 1);
+                for (std::size_t c = hi; c > lo; --c) deques_[self].push(static_cast<std::uint64_t>(c - 1));
+                worker_loop(self, chunk_body);
+            };
+            pool_.run(body);
+
+            return stats_.combine(short(0), [](short acc, const ThreadStats& s) {
+                return static_cast<short>(acc + s.acc);
+            });
+        }
+
+        void reset_stats() {
+            stats_.reset();
+        }
+
+    private:
+        template <class Body>
+        void worker_loop(unsigned self, Body& chunk_body) {
+            ThreadStats& st = stats_[self];
+            ChaseLevDeque<std::uint64_t>& mine = deques_[self];
+            std::uint64_t rng = 0x9E3779B97F4A7C15ull * (self + 1);
+            std::size_t done = 0;
+            short acc = 0;
+            std::uint64_t chunk;
+            unsigned idle = 0;
+            for (;;) {
+                while (mine.pop(chunk)) {
+                    acc += chunk_body(chunk);
+                    ++done;
+                }
+                // Publish completed work only when going idle, so the shared
+                // counter is touched once per steal round rather than per chunk.
+                if (done) {
+                    remaining_.fetch_sub(done, std::memory_order_acq_rel);
+                    st.chunks += done;
+                    done = 0;
+                }
+                if (remaining_.load(std::memory_order_acquire) == 0) break;
+                if (steal_half(self, rng, st)) {
+                    idle = 0;
+                } else if (++idle < 64) {
+                    cpu_relax();
+                } else {
+                    std::this_thread::yield();  // oversubscribed: let the owners run
+                }
+            }
+            st.acc += acc;
+        }
+
+        bool steal_half(unsigned self, std::uint64_t& rng, ThreadStats& st) {
+            const unsigned parts = static_cast<unsigned>(deques_.size());
+            if (parts < 2) return false;
+            rng ^= rng << 13;
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+            unsigned start = static_cast<unsigned>(rng % parts);
+            for (unsigned k = 0; k < parts; ++k) {
+                unsigned victim = (start + k) % parts;
+                if (victim == self) continue;
+                ++st.steal_attempts;
+                ChaseLevDeque<std::uint64_t>& d = deques_[victim];
+                std::int64_t want = (d.size_approx() + 1) / 2;
+                std::int64_t room = static_cast<std::int64_t>(deques_[self].capacity());
+                if (want > room) want = room;  // our deque is empty here
+                std::int64_t got = 0;
+                std::uint64_t chunk;
+                while (got < want && d.steal(chunk)) {
+                    deques_[self].push(chunk);
+                    ++got;
+                }
+                if (got) {
+                    ++st.steals;
+                    st.stolen += static_cast<std::uint64_t>(got);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        WorkerPool& pool_;
+        std::vector<ChaseLevDeque<std::uint64_t>> deques_;
+        PerThread<ThreadStats> stats_;
+        alignas(kCacheLine) std::atomic<std::size_t> remaining_{0};
+    };
+}
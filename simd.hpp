@@ -0,0 +1,327 @@
+// === VGC 2.5 PPE SIMD Loop Kernels (Runtime Dispatch, Short Checksum) ===
+// loop_chunk rewritten with lane-wise 16-bit accumulators and a strength-
+// reduced modulo, selected by CPUID at startup. Build without -march=native;
+// each kernel carries its own target attribute.
+
+#pragma once
+
+#include "workloads.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#define VGC_X86 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define VGC_X86 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define VGC_NEON 1
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VGC_TARGET(isa) __attribute__((target(isa)))
+#else
+#define VGC_TARGET(isa)
+#endif
+
+// ============================================================
+// Strength reduction: v_i = (2i + 1) % 32767 grows by 2 per step and wraps
+// at 32767, so each lane steps by 2 * (lanes in flight) and subtracts 32767
+// at most once. The conditional subtract is branch-free in 16 bits:
+//   t = v + step - 32767;  v' = t + (32767 & (t >> 15))
+// which holds while step < 32767. Adding shorts wraps mod 2^16, so lane
+// partials reduce to exactly the scalar loop_chunk checksum.
+// ============================================================
+namespace simd {
+    constexpr int kMod = 32767;
+
+    inline std::uint32_t seq_start(std::size_t i) { return static_cast<std::uint32_t>((2 * i + 1) % kMod); }
+
+    inline std::uint32_t seq_advance(std::uint32_t v, std::uint32_t step) {
+        v += step;
+        return v >= static_cast<std::uint32_t>(kMod) ? v - kMod : v;
+    }
+
+    // Scalar strength-reduced loop; also finishes every vector kernel's tail.
+    inline short tail(std::uint32_t v, std::size_t count, short acc) {
+        for (std::size_t k = 0; k < count; ++k) {
+            acc += static_cast<short>(v);
+            v = seq_advance(v, 2);
+        }
+        return acc;
+    }
+
+    inline short loop_scalar_sr(std::size_t begin, std::size_t end) {
+        if (end <= begin) return 0;
+        return tail(seq_start(begin), end - begin, 0);
+    }
+
+    // Fills lanes[0..n) with consecutive sequence values starting at `begin`.
+    inline void seed_lanes(std::size_t begin, std::int16_t* lanes, int n) {
+        std::uint32_t v = seq_start(begin);
+        for (int k = 0; k < n; ++k) {
+            lanes[k] = static_cast<std::int16_t>(v);
+            v = seq_advance(v, 2);
+        }
+    }
+
+#if defined(VGC_X86)
+    // 4 vectors of 8 lanes in flight; 32 sequence values per iteration.
+    VGC_TARGET("sse2")
+    inline short loop_sse2(std::size_t begin, std::size_t end) {
+        if (end <= begin) return 0;
+        const std::size_t n = end - begin, W = 32, blocks = n / W;
+        alignas(16) std::int16_t lanes[W];
+        seed_lanes(begin, lanes, static_cast<int>(W));
+        __m128i v0 = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes + 0));
+        __m128i v1 = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes + 8));
+        __m128i v2 = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes + 16));
+        __m128i v3 = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes + 24));
+        const __m128i step_m = _mm_set1_epi16(static_cast<short>(2 * W - kMod));
+        const __m128i mod = _mm_set1_epi16(kMod);
+        __m128i a0 = _mm_setzero_si128(), a1 = a0, a2 = a0, a3 = a0;
+        for (std::size_t b = 0; b < blocks; ++b) {
+            a0 = _mm_add_epi16(a0, v0);
+            a1 = _mm_add_epi16(a1, v1);
+            a2 = _mm_add_epi16(a2, v2);
+            a3 = _mm_add_epi16(a3, v3);
+            __m128i t0 = _mm_add_epi16(v0, step_m), t1 = _mm_add_epi16(v1, step_m);
+            __m128i t2 = _mm_add_epi16(v2, step_m), t3 = _mm_add_epi16(v3, step_m);
+            v0 = _mm_add_epi16(t0, _mm_and_si128(_mm_srai_epi16(t0, 15), mod));
+            v1 = _mm_add_epi16(t1, _mm_and_si128(_mm_srai_epi16(t1, 15), mod));
+            v2 = _mm_add_epi16(t2, _mm_and_si128(_mm_srai_epi16(t2, 15), mod));
+            v3 = _mm_add_epi16(t3, _mm_and_si128(_mm_srai_epi16(t3, 15), mod));
+        }
+        __m128i acc = _mm_add_epi16(_mm_add_epi16(a0, a1), _mm_add_epi16(a2, a3));
+        alignas(16) std::int16_t out[8];
+        _mm_store_si128(reinterpret_cast<__m128i*>(out), acc);
+        short sum = 0;
+        for (std::int16_t x : out) sum += x;
+        std::uint32_t next = static_cast<std::uint16_t>(_mm_cvtsi128_si32(v0) & 0xFFFF);
+        return tail(next, n - blocks * W, sum);
+    }
+
+    // 4 vectors of 16 lanes in flight; 64 sequence values per iteration.
+    VGC_TARGET("avx2")
+    inline short loop_avx2(std::size_t begin, std::size_t end) {
+        if (end <= begin) return 0;
+        const std::size_t n = end - begin, W = 64, blocks = n / W;
+        alignas(32) std::int16_t lanes[W];
+        seed_lanes(begin, lanes, static_cast<int>(W));
+        __m256i v0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes + 0));
+        __m256i v1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes + 16));
+        __m256i v2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes + 32));
+        __m256i v3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes + 48));
+        const __m256i step_m = _mm256_set1_epi16(static_cast<short>(2 * W - kMod));
+        const __m256i mod = _mm256_set1_epi16(kMod);
+        __m256i a0 = _mm256_setzero_si256(), a1 = a0, a2 = a0, a3 = a0;
+        for (std::size_t b = 0; b < blocks; ++b) {
+            a0 = _mm256_add_epi16(a0, v0);
+            a1 = _mm256_add_epi16(a1, v1);
+            a2 = _mm256_add_epi16(a2, v2);
+            a3 = _mm256_add_epi16(a3, v3);
+            __m256i t0 = _mm256_add_epi16(v0, step_m), t1 = _mm256_add_epi16(v1, step_m);
+            __m256i t2 = _mm256_add_epi16(v2, step_m), t3 = _mm256_add_epi16(v3, step_m);
+            v0 = _mm256_add_epi16(t0, _mm256_and_si256(_mm256_srai_epi16(t0, 15), mod));
+            v1 = _mm256_add_epi16(t1, _mm256_and_si256(_mm256_srai_epi16(t1, 15), mod));
+            v2 = _mm256_add_epi16(t2, _mm256_and_si256(_mm256_srai_epi16(t2, 15), mod));
+            v3 = _mm256_add_epi16(t3, _mm256_and_si256(_mm256_srai_epi16(t3, 15), mod));
+        }
+        __m256i acc = _mm256_add_epi16(_mm256_add_epi16(a0, a1), _mm256_add_epi16(a2, a3));
+        alignas(32) std::int16_t out[16];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out), acc);
+        short sum = 0;
+        for (std::int16_t x : out) sum += x;
+        std::uint32_t next = static_cast<std::uint16_t>(_mm256_extract_epi16(v0, 0));
+        return tail(next, n - blocks * W, sum);
+    }
+
+    // 4 vectors of 32 lanes in flight; 128 sequence values per iteration.
+    VGC_TARGET("avx512f,avx512bw")
+    inline short loop_avx512(std::size_t begin, std::size_t end) {
+        if (end <= begin) return 0;
+        const std::size_t n = end - begin, W = 128, blocks = n / W;
+        alignas(64) std::int16_t lanes[W];
+        seed_lanes(begin, lanes, static_cast<int>(W));
+        __m512i v0 = _mm512_load_si512(lanes + 0);
+        __m512i v1 = _mm512_load_si512(lanes + 32);
+        __m512i v2 = _mm512_load_si512(lanes + 64);
+        __m512i v3 = _mm512_load_si512(lanes + 96);
+        const __m512i step_m = _mm512_set1_epi16(static_cast<short>(2 * W - kMod));
+        const __m512i mod = _mm512_set1_epi16(kMod);
+        __m512i a0 = _mm512_setzero_si512(), a1 = a0, a2 = a0, a3 = a0;
+        for (std::size_t b = 0; b < blocks; ++b) {
+            a0 = _mm512_add_epi16(a0, v0);
+            a1 = _mm512_add_epi16(a1, v1);
+            a2 = _mm512_add_epi16(a2, v2);
+            a3 = _mm512_add_epi16(a3, v3);
+            __m512i t0 = _mm512_add_epi16(v0, step_m), t1 = _mm512_add_epi16(v1, step_m);
+            __m512i t2 = _mm512_add_epi16(v2, step_m), t3 = _mm512_add_epi16(v3, step_m);
+            v0 = _mm512_add_epi16(t0, _mm512_and_si512(_mm512_srai_epi16(t0, 15), mod));
+            v1 = _mm512_add_epi16(t1, _mm512_and_si512(_mm512_srai_epi16(t1, 15), mod));
+            v2 = _mm512_add_epi16(t2, _mm512_and_si512(_mm512_srai_epi16(t2, 15), mod));
+            v3 = _mm512_add_epi16(t3, _mm512_and_si512(_mm512_srai_epi16(t3, 15), mod));
+        }
+        __m512i acc = _mm512_add_epi16(_mm512_add_epi16(a0, a1), _mm512_add_epi16(a2, a3));
+        alignas(64) std::int16_t out[32];
+        _mm512_store_si512(out, acc);
+        _mm512_store_si512(lanes, v0);
+        short sum = 0;
+        for (std::int16_t x : out) sum += x;
+        return tail(static_cast<std::uint16_t>(lanes[0]), n - blocks * W, sum);
+    }
+#endif
+
+#if defined(VGC_NEON)
+    // 4 vectors of 8 lanes in flight; 32 sequence values per iteration.
+    inline short loop_neon(std::size_t begin, std::size_t end) {
+        if (end <= begin) return 0;
+        const std::size_t n = end - begin, W = 32, blocks = n / W;
+        std::int16_t lanes[W];
+        seed_lanes(begin, lanes, static_cast<int>(W));
+        int16x8_t v0 = vld1q_s16(lanes + 0), v1 = vld1q_s16(lanes + 8);
+        int16x8_t v2 = vld1q_s16(lanes + 16), v3 = vld1q_s16(lanes + 24);
+        const int16x8_t step_m = vdupq_n_s16(static_cast<short>(2 * W - kMod));
+        const int16x8_t mod = vdupq_n_s16(kMod);
+        int16x8_t a0 = vdupq_n_s16(0), a1 = a0, a2 = a0, a3 = a0;
+        for (std::size_t b = 0; b < blocks; ++b) {
+            a0 = vaddq_s16(a0, v0);
+            a1 = vaddq_s16(a1, v1);
+            a2 = vaddq_s16(a2, v2);
+            a3 = vaddq_s16(a3, v3);
+            int16x8_t t0 = vaddq_s16(v0, step_m), t1 = vaddq_s16(v1, step_m);
+            int16x8_t t2 = vaddq_s16(v2, step_m), t3 = vaddq_s16(v3, step_m);
+            v0 = vaddq_s16(t0, vandq_s16(vshrq_n_s16(t0, 15), mod));
+            v1 = vaddq_s16(t1, vandq_s16(vshrq_n_s16(t1, 15), mod));
+            v2 = vaddq_s16(t2, vandq_s16(vshrq_n_s16(t2, 15), mod));
+            v3 = vaddq_s16(t3, vandq_s16(vshrq_n_s16(t3, 15), mod));
+        }
+        int16x8_t acc = vaddq_s16(vaddq_s16(a0, a1), vaddq_s16(a2, a3));
+        std::int16_t out[8];
+        vst1q_s16(out, acc);
+        short sum = 0;
+        for (std::int16_t x : out) sum += x;
+        return tail(static_cast<std::uint16_t>(vgetq_lane_s16(v0, 0)), n - blocks * W, sum);
+    }
+#endif
+
+    // ============================================================
+    // CPU feature detection (AVX needs both CPUID bits and OS-enabled
+    // register state in XCR0).
+    // ============================================================
+    struct CpuFeatures {
+        bool sse2 = false, avx2 = false, avx512bw = false, neon = false;
+        bool popcnt = false, bmi1 = false;
+    };
+
+#if defined(VGC_X86)
+    inline void cpuid(unsigned leaf, unsigned sub, unsigned r[4]) {
+#if defined(_MSC_VER)
+        int regs[4];
+        __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(sub));
+        for (int k = 0; k < 4; ++k) r[k] = static_cast<unsigned>(regs[k]);
+#else
+        __cpuid_count(leaf, sub, r[0], r[1], r[2], r[3]);
+#endif
+    }
+
+    inline std::uint64_t xgetbv0() {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        unsigned lo, hi;
+        asm volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        return (static_cast<std::uint64_t>(hi) << 32) | lo;
+#endif
+    }
+#endif
+
+    inline CpuFeatures detect_cpu() {
+        CpuFeatures f;
+#if defined(VGC_X86)
+        unsigned r[4];
+        cpuid(0, 0, r);
+        unsigned max_leaf = r[0];
+        cpuid(1, 0, r);
+        f.sse2 = (r[3] >> 26) & 1;
+        f.popcnt = (r[2] >> 23) & 1;
+        bool osxsave = (r[2] >> 27) & 1;
+        std::uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+        bool ymm_os = (xcr0 & 0x6) == 0x6;
+        bool zmm_os = (xcr0 & 0xE6) == 0xE6;
+        if (max_leaf >= 7) {
+            cpuid(7, 0, r);
+            f.avx2 = ymm_os && ((r[1] >> 5) & 1);
+            f.bmi1 = (r[1] >> 3) & 1;
+            f.avx512bw = zmm_os && ((r[1] >> 16) & 1) && ((r[1] >> 30) & 1);  // F + BW
+        }
+#endif
+#if defined(VGC_NEON)
+        f.neon = true;
+#endif
+        return f;
+    }
+
+    inline const CpuFeatures& cpu() {
+        static const CpuFeatures f = detect_cpu();
+        return f;
+    }
+
+    // ============================================================
+    // Kernel table, best first. select_loop_kernel() returns the first
+    // supported entry; the scalar kernels are always available.
+    // ============================================================
+    struct LoopKernel {
+        const char* name;
+        short (*fn)(std::size_t begin, std::size_t end);
+        bool (*supported)();
+    };
+
+    inline bool always() { return true; }
+#if defined(VGC_X86)
+    inline bool has_avx512bw() { return cpu().avx512bw; }
+    inline bool has_avx2() { return cpu().avx2; }
+    inline bool has_sse2() { return cpu().sse2; }
+#endif
+
+    inline const LoopKernel* loop_kernels(std::size_t& count) {
+        static const LoopKernel table[] = {
+#if defined(VGC_X86)
+            {"avx512", loop_avx512, has_avx512bw},
+            {"avx2", loop_avx2, has_avx2},
+            {"sse2", loop_sse2, has_sse2},
+#endif
+#if defined(VGC_NEON)
+            {"neon", loop_neon, always},
+#endif
+            {"scalar_sr", loop_scalar_sr, always},
+            {"scalar", loop_chunk, always},
+        };
+        count = sizeof(table) / sizeof(table[0]);
+        return table;
+    }
+
+    inline const LoopKernel* find_loop_kernel(const char* name) {
+        std::size_t count = 0;
+        const LoopKernel* table = loop_kernels(count);
+        for (std::size_t k = 0; k < count; ++k)
+            if (!std::strcmp(table[k].name, name)) return &table[k];
+        return nullptr;
+    }
+
+    inline const LoopKernel& select_loop_kernel() {
+        std::size_t count = 0;
+        const LoopKernel* table = loop_kernels(count);
+        for (std::size_t k = 0; k < count; ++k)
+            if (table[k].supported()) return table[k];
+        return table[count - 1];
+    }
+}
@@ -0,0 +1,276 @@
+// === VGC 2.5 PPE Heap Snapshots (Relocatable Constant Zone, Mapped Read-Only) ===
+// A frozen constant layer and its checkpoint bitfield written to a file and mapped back with no fixup.
+
+#pragma once
+
+#include "bitfield.hpp"
+#include "measure.hpp"
+#include "sys.hpp"
+#include "zone.hpp"
+#include "zone_workloads.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vgc {
+    // ============================================================
+    // Snapshot file, in native byte order (the build that writes it reads
+    // it):
+    //
+    //   SnapshotHeader  at 0
+    //   image           at image_offset: the zone's [base, top), verbatim
+    //   checkpoint      at bits_offset: one bit per image slot, set on the
+    //                   slot each object starts at
+    //
+    // Both sections start on a kSnapshotAlign boundary. Constants refer to
+    // each other by slot, which is also the index of their checkpoint bit,
+    // and never by address. The image is therefore valid wherever it is
+    // mapped. MappedSnapshot checks the header and hands out the mapped
+    // bytes as they are, without touching an object; the walk ignores
+    // checkpoint bits and refs past the image's last slot, so a corrupt
+    // file reads nothing outside the mapping.
+    // ============================================================
+    constexpr char kSnapshotMagic[8] = {'V', 'G', 'C', 'S', 'N', 'A', 'P', '1'};
+    constexpr std::uint32_t kSnapshotVersion = 1;
+    constexpr std::size_t kSnapshotAlign = 4096;
+
+    struct SnapshotHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t slot_bytes;
+        std::uint64_t objects;
+        std::uint64_t image_offset, image_bytes;
+        std::uint64_t bits_offset, bit_words;
+    };
+
+    // A constant. ref[] holds the target's slot + 1, or 0 for none.
+    struct ConstCell {
+        std::uint32_t ref[2];
+        std::uint32_t bytes;   // size passed to alloc()
+        short value;
+    };
+    static_assert(sizeof(ConstCell) <= kSlotBytes, "a constant's fields must fit in its first slot");
+
+    // A constant image and its checkpoint words, in a zone or a mapping.
+    struct ImageView {
+        const char* base = nullptr;
+        std::size_t image_bytes = 0;
+        const std::uint64_t* checkpoint = nullptr;
+        std::size_t slots = 0;   // image_bytes / kSlotBytes
+        std::size_t words = 0;   // (slots + 63) / 64
+        std::size_t objects = 0;
+    };
+
+    inline const ConstCell* resolve(const ImageView& v, std::uint32_t ref) {
+        return ref && ref <= v.slots ? reinterpret_cast<const ConstCell*>(v.base + std::size_t(ref - 1) * kSlotBytes)
+                                     : nullptr;
+    }
+
+    // Every constant in address order, found by its checkpoint bit. Sums
+    // its value and its ref[0]'s, so a reference resolved wrongly changes
+    // the checksum; ref[1] is read too.
+    inline short walk_constants(const ImageView& v) {
+        short acc = 0;
+        std::uint32_t seen = 0;
+        for (std::size_t w = 0; w < v.words; ++w) {
+            std::uint64_t bits = v.checkpoint[w];
+            if (w + 1 == v.words && v.slots % 64) bits &= (std::uint64_t(1) << (v.slots % 64)) - 1;
+            for (; bits; bits &= bits - 1) {
+                std::size_t slot = w * 64 + ctz64(bits);
+                const ConstCell* c = reinterpret_cast<const ConstCell*>(v.base + slot * kSlotBytes);
+                acc += c->value;
+                if (const ConstCell* prev = resolve(v, c->ref[0])) acc += prev->value;
+                if (const ConstCell* far = resolve(v, c->ref[1])) seen ^= far->bytes;
+            }
+        }
+        sys::do_not_optimize(seen);
+        return acc;
+    }
+
+    // Writes `z`'s used range and the checkpoint words covering it.
+    inline bool write_snapshot(const char* path, const Zone& z, const Bitfield& checkpoint, std::size_t objects) {
+        SnapshotHeader h{};
+        std::memcpy(h.magic, kSnapshotMagic, sizeof(h.magic));
+        h.version = kSnapshotVersion;
+        h.slot_bytes = static_cast<std::uint32_t>(kSlotBytes);
+        h.objects = objects;
+        h.image_offset = kSnapshotAlign;
+        h.image_bytes = z.used_bytes();
+        h.bits_offset = round_up(h.image_offset + h.image_bytes, kSnapshotAlign);
+        h.bit_words = (z.slot_count() + 63) / 64;
+        if (h.bit_words > checkpoint.words()) return false;
+
+        std::FILE* f = std::fopen(path, "wb");
+        if (!f) return false;
+        static const char zeros[kSnapshotAlign] = {};
+        bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+        ok = ok && std::fwrite(zeros, 1, h.image_offset - sizeof(h), f) == h.image_offset - sizeof(h);
+        ok = ok && (!h.image_bytes || std::fwrite(z.slot_address(0), 1, h.image_bytes, f) == h.image_bytes);
+        std::size_t pad = static_cast<std::size_t>(h.bits_offset - h.image_offset - h.image_bytes);
+        ok = ok && std::fwrite(zeros, 1, pad, f) == pad;
+        ok = ok && (!h.bit_words ||
+                    std::fwrite(checkpoint.data(), sizeof(std::uint64_t), h.bit_words, f) == h.bit_words);
+        ok = (std::fclose(f) == 0) && ok;
+        return ok;
+    }
+
+    // ============================================================
+    // A snapshot mapped read-only. The view points into the mapping and
+    // lives as long as it; close() or the destructor unmaps it.
+    // ============================================================
+    class MappedSnapshot {
+    public:
+        MappedSnapshot() = default;
+        MappedSnapshot(const MappedSnapshot&) = delete;
+        MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+        ~MappedSnapshot() { close(); }
+
+        // False for a missing or truncated file, or one from another build.
+        // Each offset is checked against what is left of the file, so a bad
+        // header cannot wrap a sum past the end; the checkpoint must have
+        // exactly one bit per image slot, rounded up to a whole word.
+        bool open(const char* path) {
+            close();
+            p_ = sys::map_file(path, bytes_);
+            if (!p_) return false;
+            const char* base = static_cast<const char*>(p_);
+            SnapshotHeader h;
+            bool valid = bytes_ >= sizeof(h);
+            if (valid) std::memcpy(&h, base, sizeof(h));
+            const std::uint64_t file = bytes_;
+            valid = valid && !std::memcmp(h.magic, kSnapshotMagic, sizeof(h.magic)) && h.version == kSnapshotVersion &&
+                    h.slot_bytes == kSlotBytes && h.image_offset % kSnapshotAlign == 0 &&
+                    h.bits_offset % kSnapshotAlign == 0 && h.image_bytes % kSlotBytes == 0 &&
+                    h.image_offset <= file && h.image_bytes <= file - h.image_offset &&
+                    h.bits_offset >= h.image_offset + h.image_bytes && h.bits_offset <= file &&
+                    h.bit_words <= (file - h.bits_offset) / sizeof(std::uint64_t) &&
+                    h.bit_words == (h.image_bytes / kSlotBytes + 63) / 64;
+            if (!valid) {
+                close();
+                return false;
+            }
+            view_.base = base + h.image_offset;
+            view_.image_bytes = static_cast<std::size_t>(h.image_bytes);
+            view_.checkpoint = reinterpret_cast<const std::uint64_t*>(base + h.bits_offset);
+            view_.slots = static_cast<std::size_t>(h.image_bytes / kSlotBytes);
+            view_.words = static_cast<std::size_t>(h.bit_words);
+            view_.objects = static_cast<std::size_t>(h.objects);
+            return true;
+        }
+
+        void close() {
+            if (p_) sys::unmap_file(p_, bytes_);
+            p_ = nullptr;
+            bytes_ = 0;
+            view_ = ImageView{};
+        }
+
+        const ImageView& view() const { return view_; }
+        std::size_t file_bytes() const { return bytes_; }
+
+    private:
+        const void* p_ = nullptr;
+        std::size_t bytes_ = 0;
+        ImageView view_;
+    };
+
+    // ============================================================
+    // Two startups of a process that needs N constants:
+    //
+    //   rebuild()  allocates them into a passive zone on fresh pages (after
+    //              trim(), as in a new process), links them, marks their
+    //              checkpoint bits, freezes the zone and walks it
+    //   map()      maps the snapshot that prepare() wrote, walks it where it
+    //              landed and unmaps it
+    //
+    // Constant k is 32..256 bytes and stores term(k). ref[0] is constant
+    // k - 1, and ref[1] is one of the earlier ones, picked by a hash of k.
+    // The walk's checksum is therefore loop_chunk(0, N) + loop_chunk(0, N - 1)
+    // either way.
+    //
+    // The file is removed on destruction unless `keep`.
+    // ============================================================
+    class ConstantSnapshot {
+    public:
+        static constexpr std::size_t kMaxBytes = 256;
+
+        ConstantSnapshot(std::string path, std::size_t zone_bytes, bool keep)
+            : path_(std::move(path)), keep_(keep), zone_(ZoneId::Passive, zone_bytes) {}
+        ConstantSnapshot(const ConstantSnapshot&) = delete;
+        ConstantSnapshot& operator=(const ConstantSnapshot&) = delete;
+        ~ConstantSnapshot() {
+            if (written_ && !keep_) std::remove(path_.c_str());
+        }
+
+        bool ok() const { return zone_.ok(); }
+        const std::string& path() const { return path_; }
+
+        // Untimed, once per N: sizes the bookkeeping and writes the snapshot.
+        bool prepare(std::size_t n) {
+            checkpoint_.resize(n * (kMaxBytes / kSlotBytes));
+            slots_.reserve(n);
+            zone_.thaw();
+            if (!build(n)) return false;
+            written_ = write_snapshot(path_.c_str(), zone_, checkpoint_, n);
+            image_bytes_ = zone_.used_bytes();
+            return written_;
+        }
+
+        short rebuild(std::size_t n) {
+            zone_.thaw();
+            zone_.trim();
+            checkpoint_.clear_all();
+            if (!build(n) || !zone_.freeze()) return 0;
+            ImageView v;
+            v.base = static_cast<const char*>(zone_.slot_address(0));
+            v.image_bytes = zone_.used_bytes();
+            v.checkpoint = checkpoint_.data();
+            v.slots = zone_.slot_count();
+            v.words = (v.slots + 63) / 64;
+            v.objects = n;
+            return walk_constants(v);
+        }
+
+        short map(std::size_t n) {
+            MappedSnapshot m;
+            if (!m.open(path_.c_str()) || m.view().objects != n) return 0;
+            return walk_constants(m.view());
+        }
+
+        std::size_t image_bytes() const { return image_bytes_; }   // as written by prepare()
+        std::size_t bitfield_bytes() const { return (image_bytes_ / kSlotBytes + 63) / 64 * sizeof(std::uint64_t); }
+
+    private:
+        bool build(std::size_t n) {
+            zone_.reset();
+            slots_.clear();
+            std::uint64_t rng = 0xA0761D6478BD642Full;
+            for (std::size_t k = 0; k < n; ++k) {
+                std::size_t size = kSlotBytes + object_bytes(rng, kMaxBytes - kSlotBytes);   // 32..256
+                ConstCell* c = static_cast<ConstCell*>(zone_.alloc(size));
+                if (!c) return false;
+                std::uint32_t slot = static_cast<std::uint32_t>(zone_.slot_index(c));
+                c->ref[0] = k ? slots_[k - 1] + 1 : 0;
+                c->ref[1] = k ? slots_[(k * 2654435761u) % k] + 1 : 0;
+                c->bytes = static_cast<std::uint32_t>(size);
+                c->value = term(k);
+                checkpoint_.mark(slot);
+                slots_.push_back(slot);
+            }
+            return true;
+        }
+
+        std::string path_;
+        bool keep_;
+        bool written_ = false;
+        Zone zone_;
+        Bitfield checkpoint_;
+        std::vector<std::uint32_t> slots_;   // of constant k
+        std::size_t image_bytes_ = 0;
+    };
+}
@@ -0,0 +1,115 @@
+// === VGC 2.5 PPE Stack Probe (Painted Stack, Bytes per Recursion Level) ===
+// How much native stack a recursion kernel really uses, to tell recursion from a tail call turned into a loop.
+
+#pragma once
+
+#include "sys.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#define VGC_NOINLINE __declspec(noinline)
+#define VGC_NO_ASAN
+#else
+#define VGC_NOINLINE __attribute__((noinline))
+#define VGC_NO_ASAN __attribute__((no_sanitize_address))
+#endif
+
+namespace deep {
+    // ============================================================
+    // Stack painting. paint_stack() fills a kPaintBytes frame with a
+    // pattern and returns, leaving the pattern just below its caller's
+    // stack pointer. The function under test then runs from the same
+    // caller and so grows its frames down into the painted bytes. The
+    // lowest byte it changed marks its peak depth.
+    //
+    // The frame is filled top down, one page after another, so a guard
+    // page that commits the stack on demand (Windows) sees each page in
+    // turn. The scan reads memory that belonged to returned frames, so it
+    // is not instrumented by AddressSanitizer.
+    // ============================================================
+    constexpr std::size_t kPaintBytes = std::size_t(4) << 20;
+    constexpr unsigned char kPaintByte = 0xA5;
+
+    VGC_NOINLINE inline void paint_stack(std::uintptr_t& low) {
+        volatile unsigned char frame[kPaintBytes];
+        for (std::size_t i = kPaintBytes; i-- > 0;) frame[i] = kPaintByte;
+        low = reinterpret_cast<std::uintptr_t>(&frame[0]);
+    }
+
+    // Bytes from the top of the painted frame down to the lowest one
+    // changed; kPaintBytes if none of the pattern survived.
+    VGC_NO_ASAN VGC_NOINLINE inline std::size_t painted_depth(std::uintptr_t low) {
+        const volatile unsigned char* p = reinterpret_cast<const volatile unsigned char*>(low);
+        std::size_t i = 0;
+        while (i < kPaintBytes && p[i] == kPaintByte) ++i;
+        return kPaintBytes - i;
+    }
+
+    template <class Fn>
+    VGC_NOINLINE std::size_t stack_used(Fn& fn) {
+        std::uintptr_t low = 0;
+        paint_stack(low);
+        short s = fn();
+        sys::do_not_optimize(s);
+        return painted_depth(low);
+    }
+
+    // ============================================================
+    // Recursion profile of one chunk. run(depth) must make one driver run
+    // of one chunk, recursing `depth` levels, on the calling thread. The
+    // probe measures d = min(depth, kProbeDepth) and d / 2 levels on a
+    // fresh thread with room for the paint. The difference per level is
+    // what one more level costs, so the driver's own frames cancel out:
+    //
+    //   bytes_per_level ~ 0   the stack does not grow with depth: the tail
+    //                         call became a loop, the chunk was folded, or
+    //                         the engine keeps its levels off the stack
+    //   bytes_per_level > 0   a real frame per level: call, return
+    //                         address, saved registers and spills
+    //
+    // Past kProbeDepth the peak is extrapolated from the measured levels.
+    // ============================================================
+    constexpr int kProbeDepth = 16384;   // at <= 256 B/level, stays inside the paint
+
+    struct StackProfile {
+        int depth = 0;                   // levels per chunk, as run
+        int measured_depth = 0;          // levels actually probed
+        std::size_t base_bytes = 0;      // peak at measured_depth / 2
+        std::size_t measured_bytes = 0;  // peak at measured_depth
+        double bytes_per_level = 0;
+        bool overflow = false;           // the recursion went past the paint
+        bool ok = false;
+
+        // Grew by more than a cache line from d / 2 to d levels. Compilers
+        // that inline a few levels into one frame (GCC -O1) recurse at a
+        // fraction of a frame per level.
+        bool recursing() const { return measured_bytes > base_bytes + 64; }
+        double peak_bytes() const {
+            return static_cast<double>(measured_bytes) + bytes_per_level * (depth - measured_depth);
+        }
+    };
+
+    template <class Run>
+    StackProfile profile_stack(Run run, int depth) {
+        StackProfile s;
+        s.depth = depth;
+        s.measured_depth = depth < kProbeDepth ? depth : kProbeDepth;
+        if (s.measured_depth < 2) return s;
+        auto probe = [&] {
+            auto shallow = [&] { return run(s.measured_depth / 2); };
+            auto deep = [&] { return run(s.measured_depth); };
+            s.base_bytes = stack_used(shallow);
+            s.measured_bytes = stack_used(deep);
+        };
+        if (!sys::run_on_stack(kPaintBytes + (std::size_t(8) << 20), probe)) return s;
+        s.overflow = s.measured_bytes >= kPaintBytes;
+        s.bytes_per_level = s.measured_bytes > s.base_bytes
+                                ? static_cast<double>(s.measured_bytes - s.base_bytes) /
+                                      (s.measured_depth - s.measured_depth / 2)
+                                : 0;
+        s.ok = !s.overflow;
+        return s;
+    }
+}
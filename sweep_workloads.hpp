@@ -0,0 +1,120 @@
+// === VGC 2.5 PPE Liveness Sweep Workloads (Bitfield vs Object Headers) ===
+// Sweeps an N-slot heap with the checkpoint bitfield and with per-object mark bits.
+
+#pragma once
+
+#include "bitfield.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vgc {
+    // ============================================================
+    // A heap of N 16-byte slots in a fixed pseudo-random state: about 90%
+    // of slots hold an object at the checkpoint, and about 70% of those
+    // were marked since. The same state is kept twice, as bitfields and as
+    // a mark byte in each object's header, so both sweeps see one heap.
+    // Each representation is built on first use for a given N.
+    // ============================================================
+    class SweepHeap {
+    public:
+        enum HeaderBits : std::uint8_t { kAllocated = 1, kMarked = 2, kFree = 4 };
+
+        struct ObjectHeader {
+            std::uint8_t flags;
+            std::uint8_t payload[15];   // the rest of the 16-byte slot
+        };
+
+        static bool allocated(std::size_t slot) { return splitmix(slot) % 100 < 90; }
+        static bool marked(std::size_t slot) { return allocated(slot) && (splitmix(slot) >> 32) % 100 < 70; }
+
+        const Bitfield& checkpoint(std::size_t n) {
+            if (checkpoint_.slots() != n) {
+                checkpoint_.resize(n);
+                mark_.resize(n);
+                out_.resize(n);
+                for (std::size_t s = 0; s < n; ++s) {
+                    if (allocated(s)) checkpoint_.mark(s);
+                    if (marked(s)) mark_.mark(s);
+                }
+            }
+            return checkpoint_;
+        }
+        const Bitfield& marks() const { return mark_; }
+        Bitfield& out() { return out_; }
+
+        std::vector<ObjectHeader>& headers(std::size_t n) {
+            if (headers_.size() != n) {
+                headers_.assign(n, ObjectHeader{});
+                for (std::size_t s = 0; s < n; ++s)
+                    headers_[s].flags = static_cast<std::uint8_t>((allocated(s) ? kAllocated : 0) |
+                                                                  (marked(s) ? kMarked : 0));
+            }
+            return headers_;
+        }
+
+        std::size_t bitfield_bytes() const { return 3 * checkpoint_.words() * sizeof(std::uint64_t); }
+        std::size_t header_bytes() const { return headers_.size() * sizeof(ObjectHeader); }
+
+    private:
+        static std::uint64_t splitmix(std::uint64_t x) {
+            x += 0x9E3779B97F4A7C15ull;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            return x ^ (x >> 31);
+        }
+
+        Bitfield checkpoint_, mark_, out_;
+        std::vector<ObjectHeader> headers_;
+    };
+
+    // Bitfield sweep: 64 slots per gate evaluation.
+    inline short bitfield_sweep(SweepHeap& heap, std::size_t n, Gate g, const SweepKernel& k) {
+        const Bitfield& c = heap.checkpoint(n);
+        return k.resolve(g)(c, heap.marks(), heap.out(), 0, c.words()).checksum;
+    }
+
+    // The same gate pass without the visit, as an offload device would run
+    // it. The result is the last output word, folded, so it is not dead.
+    inline short bitfield_gate_only(SweepHeap& heap, std::size_t n, Gate g, const SweepKernel& k) {
+        const Bitfield& c = heap.checkpoint(n);
+        if (c.words() == 0) return 0;
+        k.gate_only(g)(c, heap.marks(), heap.out(), 0, c.words());
+        std::uint64_t last = heap.out().data()[c.words() - 1];
+        return static_cast<short>(last ^ (last >> 16) ^ (last >> 32) ^ (last >> 48));
+    }
+
+    // Traditional sweep: visit every object's header, evaluate the gate on
+    // its two bits and record the result in the header.
+    template <Gate G>
+    inline short header_sweep_g(std::vector<SweepHeap::ObjectHeader>& hs) {
+        short acc = 0;
+        for (std::size_t s = 0; s < hs.size(); ++s) {
+            std::uint8_t f = hs[s].flags;
+            std::uint64_t c = f & SweepHeap::kAllocated, m = (f >> 1) & 1;
+            if (eval<G>(c, m) & 1) {
+                hs[s].flags = static_cast<std::uint8_t>(f | SweepHeap::kFree);
+                acc = static_cast<short>(acc + static_cast<short>(s));
+            } else {
+                hs[s].flags = static_cast<std::uint8_t>(f & ~SweepHeap::kFree);
+            }
+        }
+        return acc;
+    }
+
+    inline short header_sweep(SweepHeap& heap, std::size_t n, Gate g) {
+        std::vector<SweepHeap::ObjectHeader>& hs = heap.headers(n);
+        switch (g) {
+            case Gate::And:    return header_sweep_g<Gate::And>(hs);
+            case Gate::Or:     return header_sweep_g<Gate::Or>(hs);
+            case Gate::Not:    return header_sweep_g<Gate::Not>(hs);
+            case Gate::Xor:    return header_sweep_g<Gate::Xor>(hs);
+            case Gate::Xnor:   return header_sweep_g<Gate::Xnor>(hs);
+            case Gate::Nor:    return header_sweep_g<Gate::Nor>(hs);
+            case Gate::Nand:   return header_sweep_g<Gate::Nand>(hs);
+            case Gate::AndNot: return header_sweep_g<Gate::AndNot>(hs);
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,87 @@
+// === VGC 2.5 PPE Benchmark System Layer ===
+// Timer, working-set probe and core pinning shared by every workload.
+//
+// The timer is portable; working_set_kb(), memory_snapshot(),
+// reset_peak_rss(), pin_to_core(), pin_to_core_and_boost(), drop_boost(),
+// run_with_stack() and the page
+// reservation calls (page_size, reserve/commit/decommit/release_pages,
+// protect_pages, the PageKind overloads of page_size/reserve_pages,
+// advise_pages, resident_bytes), read-only file views (map_file,
+// unmap_file), the host description (host_name, cpu_model, cpu_governor,
+// cpu_topology) and NUMA placement
+// (commit_pages_on_node) come from one platform backend:
+//   sys_windows.hpp  psapi GetProcessMemoryInfo, SetThreadAffinityMask
+//   sys_linux.hpp    /proc/self/statm, pthread_setaffinity_np, sched_setscheduler
+//   sys_macos.hpp    task_info, thread affinity tags, QoS class
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace sys {
+    struct Timer {
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point start;
+        Timer() : start(Clock::now()) {}
+        double ms() const {
+            using dur = std::chrono::duration<double, std::milli>;
+            return std::chrono::duration_cast<dur>(Clock::now() - start).count();
+        }
+    };
+
+    // Point-in-time process memory counters. Fault counts are cumulative
+    // for the process; diff two snapshots for a run.
+    struct MemorySnapshot {
+        std::size_t rss_kb = 0;
+        std::size_t peak_rss_kb = 0;      // high-water mark since start or last reset_peak_rss()
+        std::uint64_t minor_faults = 0;   // Windows: all faults (soft and hard are not split)
+        std::uint64_t major_faults = 0;
+    };
+
+    // Backing for a page reservation. Transparent asks the kernel to fold
+    // committed ranges into 2 MB pages (Linux THP); Huge2M / Huge1G take
+    // explicit large pages, which are committed for the whole reservation up
+    // front (hugetlb pool, or MEM_LARGE_PAGES with SeLockMemoryPrivilege).
+    enum class PageKind : unsigned char { Normal, Transparent, Huge2M, Huge1G };
+
+    inline const char* page_kind_name(PageKind k) {
+        switch (k) {
+            case PageKind::Normal:      return "normal";
+            case PageKind::Transparent: return "thp";
+            case PageKind::Huge2M:      return "2m";
+            case PageKind::Huge1G:      return "1g";
+        }
+        return "?";
+    }
+
+    // Where one logical CPU sits. Ids are as the OS numbers them and need not
+    // be dense; `core` is unique only within its package.
+    struct CpuPlace {
+        unsigned cpu = 0;
+        unsigned package = 0;
+        unsigned node = 0;   // NUMA node
+        unsigned core = 0;
+        unsigned l3 = 0;     // any id shared exactly by the CPUs of one L3
+    };
+}
+
+#if defined(_WIN32)
+#include "sys_windows.hpp"
+#elif defined(__linux__)
+#include "sys_linux.hpp"
+#elif defined(__APPLE__)
+#include "sys_macos.hpp"
+#else
+#error "sys: no platform backend for this target"
+#endif
+
+namespace sys {
+    // Runs fn() to completion on a fresh thread with a `stack_bytes` stack.
+    // Returns false if the thread could not be created.
+    template <class Fn>
+    bool run_on_stack(std::size_t stack_bytes, Fn& fn) {
+        return run_with_stack(stack_bytes, [](void* ctx) { (*static_cast<Fn*>(ctx))(); }, &fn);
+    }
+}
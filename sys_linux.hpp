@@ -0,0 +1,364 @@
+// === VGC 2.5 PPE System Backend: Linux ===
+// Link: -pthread
+
+#pragma once
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace sys {
+    inline const char* platform_name() { return "linux"; }
+
+    // Resident set from /proc/self/statm (second field, in pages) -- the
+    // same quantity WorkingSetSize reports on Windows. Falls back to
+    // ru_maxrss (peak, KB) when procfs is not mounted.
+    inline std::size_t working_set_kb() {
+        if (std::FILE* f = std::fopen("/proc/self/statm", "r")) {
+            unsigned long size = 0, resident = 0;
+            int got = std::fscanf(f, "%lu %lu", &size, &resident);
+            std::fclose(f);
+            if (got == 2) {
+                long page = sysconf(_SC_PAGESIZE);
+                return static_cast<std::size_t>(resident) * static_cast<std::size_t>(page) / 1024;
+            }
+        }
+        rusage ru{};
+        if (getrusage(RUSAGE_SELF, &ru) == 0) return static_cast<std::size_t>(ru.ru_maxrss);
+        return 0;
+    }
+
+    inline MemorySnapshot memory_snapshot() {
+        MemorySnapshot m;
+        m.rss_kb = working_set_kb();
+        rusage ru{};
+        if (getrusage(RUSAGE_SELF, &ru) == 0) {
+            m.peak_rss_kb = static_cast<std::size_t>(ru.ru_maxrss);
+            m.minor_faults = static_cast<std::uint64_t>(ru.ru_minflt);
+            m.major_faults = static_cast<std::uint64_t>(ru.ru_majflt);
+        }
+        return m;
+    }
+
+    // Writing "5" to clear_refs resets the RSS high-water mark that
+    // ru_maxrss reports (Linux 4.0+), so each run gets its own peak.
+    inline bool reset_peak_rss() {
+        std::FILE* f = std::fopen("/proc/self/clear_refs", "w");
+        if (!f) return false;
+        bool ok = std::fputs("5", f) >= 0;
+        ok = (std::fclose(f) == 0) && ok;
+        return ok;
+    }
+
+    // ============================================================
+    // Address space: reserve PROT_NONE, commit by mprotect; MAP_NORESERVE
+    // keeps a large reservation from counting against overcommit.
+    // ============================================================
+    inline std::size_t page_size() { return static_cast<std::size_t>(sysconf(_SC_PAGESIZE)); }
+
+    inline void* reserve_pages(std::size_t bytes) {
+        void* p = mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    inline bool commit_pages(void* p, std::size_t bytes) {
+        return mprotect(p, bytes, PROT_READ | PROT_WRITE) == 0;
+    }
+
+    // Drops the physical pages; the range stays committed and reads back zero.
+    inline void decommit_pages(void* p, std::size_t bytes) { madvise(p, bytes, MADV_DONTNEED); }
+
+    inline void release_pages(void* p, std::size_t bytes) { munmap(p, bytes); }
+
+    // Committed pages only; read-only pages fault on any write.
+    inline bool protect_pages(void* p, std::size_t bytes, bool writable) {
+        return mprotect(p, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ) == 0;
+    }
+
+    // ============================================================
+    // Read-only file views: the whole file, mapped private and never
+    // written, so its pages are the page cache's and every process mapping
+    // the same file shares them. nullptr for a missing or empty file.
+    // ============================================================
+    inline const void* map_file(const char* path, std::size_t& bytes) {
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return nullptr;
+        struct stat st;
+        void* p = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            bytes = static_cast<std::size_t>(st.st_size);
+            p = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);   // the mapping keeps the file open
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    inline void unmap_file(const void* p, std::size_t bytes) { munmap(const_cast<void*>(p), bytes); }
+
+    // ============================================================
+    // Large pages. THP: a 2 MB-aligned PROT_NONE reservation whose commits
+    // are madvise(MADV_HUGEPAGE)d, so it works with THP set to "madvise".
+    // hugetlb: mapped read-write in full from the pool sized by
+    // /proc/sys/vm/nr_hugepages (or nr_overcommit_hugepages); mmap fails
+    // cleanly when the pool is short.
+    // ============================================================
+    inline std::size_t page_size(PageKind k) {
+        switch (k) {
+            case PageKind::Normal:      return page_size();
+            case PageKind::Transparent:
+            case PageKind::Huge2M:      return std::size_t(2) << 20;
+            case PageKind::Huge1G:      return std::size_t(1) << 30;
+        }
+        return 0;
+    }
+
+    // `committed` is set when the range is usable without commit_pages().
+    inline void* reserve_pages(std::size_t bytes, PageKind k, bool& committed) {
+        committed = false;
+        if (k == PageKind::Normal) return reserve_pages(bytes);
+        std::size_t align = page_size(k);
+        if (k == PageKind::Transparent) {
+            char* raw = static_cast<char*>(reserve_pages(bytes + align));
+            if (!raw) return nullptr;
+            char* p = raw + (align - reinterpret_cast<std::uintptr_t>(raw) % align) % align;
+            if (p != raw) munmap(raw, static_cast<std::size_t>(p - raw));
+            munmap(p + bytes, static_cast<std::size_t>(raw + align - p));
+            return p;
+        }
+#if defined(MAP_HUGETLB)
+        constexpr int kHugeShift = 26;   // MAP_HUGE_SHIFT
+        int size_flag = (k == PageKind::Huge1G ? 30 : 21) << kHugeShift;
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | size_flag,
+                       -1, 0);
+        if (p == MAP_FAILED) return nullptr;
+        committed = true;
+        return p;
+#else
+        return nullptr;
+#endif
+    }
+
+    // For newly committed ranges of a reservation of kind `k`.
+    inline void advise_pages(void* p, std::size_t bytes, PageKind k) {
+#if defined(MADV_HUGEPAGE)
+        if (k == PageKind::Transparent) madvise(p, bytes, MADV_HUGEPAGE);
+#else
+        (void)p, (void)bytes, (void)k;
+#endif
+    }
+
+    // Bytes of [p, p + bytes) backed by physical memory right now, which
+    // RSS cannot tell apart from the rest of the process. `p` must be
+    // page-aligned.
+    inline std::size_t resident_bytes(const void* p, std::size_t bytes) {
+        const std::size_t page = page_size(), chunk = std::size_t(1) << 14;   // pages per mincore call
+        std::vector<unsigned char> vec(chunk);
+        std::size_t resident = 0;
+        for (std::size_t off = 0; off < bytes; off += chunk * page) {
+            std::size_t len = bytes - off < chunk * page ? bytes - off : chunk * page;
+            void* at = const_cast<char*>(static_cast<const char*>(p) + off);
+            if (mincore(at, len, vec.data()) != 0) return resident;
+            for (std::size_t i = 0; i < (len + page - 1) / page; ++i) resident += (vec[i] & 1) ? page : 0;
+        }
+        return resident;
+    }
+
+    // Commits and sets a preferred-node policy on the range before anything
+    // touches it, so its pages fault in on `node` while that node has free
+    // memory (and elsewhere after, rather than failing). Raw mbind(2), so
+    // libnuma is not needed.
+    inline bool commit_pages_on_node(void* p, std::size_t bytes, unsigned node) {
+        if (!commit_pages(p, bytes)) return false;
+        constexpr unsigned kMaxNodes = 1024;
+        if (node >= kMaxNodes) return false;
+        unsigned long mask[kMaxNodes / (8 * sizeof(unsigned long))] = {};
+        mask[node / (8 * sizeof(unsigned long))] = 1ul << (node % (8 * sizeof(unsigned long)));
+        return syscall(SYS_mbind, p, bytes, MPOL_PREFERRED, mask, kMaxNodes + 1, 0) == 0;
+    }
+
+    // ============================================================
+    // Host description for result records; "" when unknown.
+    // ============================================================
+    inline std::string host_name() {
+        char buf[256] = {};
+        return gethostname(buf, sizeof(buf) - 1) == 0 ? buf : "";
+    }
+
+    // First line of `path` without its newline.
+    inline std::string read_line(const char* path) {
+        std::string s;
+        if (std::FILE* f = std::fopen(path, "r")) {
+            char buf[256];
+            if (std::fgets(buf, sizeof(buf), f)) s = buf;
+            std::fclose(f);
+        }
+        while (!s.empty() && (s.back() == '\n' || s.back() == ' ')) s.pop_back();
+        return s;
+    }
+
+    // "model name" on x86; AArch64 kernels list no model name, only part numbers.
+    inline std::string cpu_model() {
+        std::string model;
+        if (std::FILE* f = std::fopen("/proc/cpuinfo", "r")) {
+            char buf[512];
+            while (std::fgets(buf, sizeof(buf), f)) {
+                if (std::strncmp(buf, "model name", 10) != 0) continue;
+                if (const char* colon = std::strchr(buf, ':')) model = colon + 1 + (colon[1] == ' ');
+                break;
+            }
+            std::fclose(f);
+        }
+        while (!model.empty() && model.back() == '\n') model.pop_back();
+        return model;
+    }
+
+    // cpufreq governor of core 0 (performance, powersave, schedutil, ...).
+    inline std::string cpu_governor() { return read_line("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor"); }
+
+    // Affinity sets sized for the host, so CPU ids past CPU_SETSIZE (1024) work.
+    inline unsigned cpu_set_bits() {
+        long conf = sysconf(_SC_NPROCESSORS_CONF);
+        return conf > 1024 ? static_cast<unsigned>(conf) : 1024u;
+    }
+
+    // "0-3,8,10-11" -> 0 1 2 3 8 10 11
+    inline std::vector<unsigned> parse_cpu_list(const std::string& s) {
+        std::vector<unsigned> out;
+        const char* p = s.c_str();
+        while (*p) {
+            char* end = nullptr;
+            unsigned long lo = std::strtoul(p, &end, 10), hi = lo;
+            if (end == p) break;
+            if (*end == '-') hi = std::strtoul(end + 1, &end, 10);
+            for (unsigned long c = lo; c <= hi; ++c) out.push_back(static_cast<unsigned>(c));
+            p = *end == ',' ? end + 1 : end;
+            if (*end != ',') break;
+        }
+        return out;
+    }
+
+    inline bool read_unsigned(const std::string& path, unsigned& out) {
+        std::string s = read_line(path.c_str());
+        char* end = nullptr;
+        unsigned long v = std::strtoul(s.c_str(), &end, 10);
+        if (s.empty() || end == s.c_str()) return false;
+        out = static_cast<unsigned>(v);
+        return true;
+    }
+
+    // The CPUs this process may run on, placed from sysfs: package and core
+    // from topology/, the L3 from the cache index whose level is 3 (its
+    // lowest shared CPU serves as the id), and nodes from node*/cpulist.
+    inline bool cpu_topology(std::vector<CpuPlace>& out) {
+        unsigned bits = cpu_set_bits();
+        cpu_set_t* set = CPU_ALLOC(bits);
+        if (!set) return false;
+        std::size_t size = CPU_ALLOC_SIZE(bits);
+        CPU_ZERO_S(size, set);
+        bool ok = sched_getaffinity(0, size, set) == 0;
+        for (unsigned c = 0; ok && c < bits; ++c) {
+            if (!CPU_ISSET_S(c, size, set)) continue;
+            std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(c);
+            CpuPlace p;
+            p.cpu = c;
+            read_unsigned(dir + "/topology/physical_package_id", p.package);
+            if (!read_unsigned(dir + "/topology/core_id", p.core)) p.core = c;
+            p.l3 = ~0u;
+            for (int idx = 0; idx < 8; ++idx) {
+                std::string cache = dir + "/cache/index" + std::to_string(idx);
+                unsigned level = 0;
+                if (!read_unsigned(cache + "/level", level) || level != 3) continue;
+                std::vector<unsigned> shared = parse_cpu_list(read_line((cache + "/shared_cpu_list").c_str()));
+                if (!shared.empty()) p.l3 = shared.front();
+            }
+            out.push_back(p);
+        }
+        CPU_FREE(set);
+        if (!ok || out.empty()) return false;
+
+        if (DIR* d = opendir("/sys/devices/system/node")) {
+            while (dirent* e = readdir(d)) {
+                unsigned node = 0;
+                if (std::sscanf(e->d_name, "node%u", &node) != 1) continue;
+                std::string list = read_line(("/sys/devices/system/node/" + std::string(e->d_name) + "/cpulist").c_str());
+                for (unsigned c : parse_cpu_list(list))
+                    for (CpuPlace& p : out)
+                        if (p.cpu == c) p.node = node;
+            }
+            closedir(d);
+        }
+        // Without an L3 listing, treat each package as one L3 domain.
+        for (CpuPlace& p : out)
+            if (p.l3 == ~0u) p.l3 = p.package << 16;
+        return true;
+    }
+
+    inline bool run_with_stack(std::size_t stack_bytes, void (*fn)(void*), void* ctx) {
+        struct Call {
+            void (*fn)(void*);
+            void* ctx;
+        } call{fn, ctx};
+        pthread_attr_t attr;
+        if (pthread_attr_init(&attr) != 0) return false;
+        pthread_t t;
+        bool ok = pthread_attr_setstacksize(&attr, stack_bytes) == 0 &&
+                  pthread_create(&t, &attr, [](void* c) -> void* {
+                      Call* k = static_cast<Call*>(c);
+                      k->fn(k->ctx);
+                      return nullptr;
+                  }, &call) == 0;
+        pthread_attr_destroy(&attr);
+        if (ok) pthread_join(t, nullptr);
+        return ok;
+    }
+
+    inline void pin_to_core(unsigned core_index) {
+        unsigned bits = cpu_set_bits();
+        if (core_index < bits) {
+            if (cpu_set_t* set = CPU_ALLOC(bits)) {
+                std::size_t size = CPU_ALLOC_SIZE(bits);
+                CPU_ZERO_S(size, set);
+                CPU_SET_S(core_index, size, set);
+                pthread_setaffinity_np(pthread_self(), size, set);
+                CPU_FREE(set);
+            }
+        }
+    }
+
+    // The lowest SCHED_FIFO priority already outranks every SCHED_OTHER
+    // thread without competing with kernel RT threads. It needs
+    // CAP_SYS_NICE; without it we try a negative nice value, and failing
+    // that only the affinity applies.
+    inline void pin_to_core_and_boost(unsigned core_index = 0) {
+        pin_to_core(core_index);
+        sched_param sp{};
+        sp.sched_priority = sched_get_priority_min(SCHED_FIFO);
+        if (sched_setscheduler(0, SCHED_FIFO, &sp) != 0)
+            setpriority(PRIO_PROCESS, 0, -10);
+    }
+
+    // A thread inherits its creator's policy and nice value, so threads
+    // started from a boosted one are SCHED_FIFO too until they call this.
+    inline void drop_boost() {
+        sched_param sp{};
+        sched_setscheduler(0, SCHED_OTHER, &sp);
+        setpriority(PRIO_PROCESS, 0, 0);
+    }
+}
@@ -0,0 +1,226 @@
+// === VGC 2.5 PPE System Backend: macOS ===
+
+#pragma once
+
+#include <fcntl.h>
+#include <mach/mach.h>
+#include <mach/vm_statistics.h>
+#include <mach/thread_policy.h>
+#include <pthread.h>
+#include <pthread/qos.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/sysctl.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sys {
+    inline const char* platform_name() { return "macos"; }
+
+    inline std::size_t working_set_kb() {
+        mach_task_basic_info info{};
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                      reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+            return static_cast<std::size_t>(info.resident_size / 1024);
+        return 0;
+    }
+
+    // `faults` counts every fault; `pageins` are the ones that hit backing
+    // store, which is the closest match to a major fault.
+    inline MemorySnapshot memory_snapshot() {
+        MemorySnapshot m;
+        mach_task_basic_info info{};
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                      reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+            m.rss_kb = static_cast<std::size_t>(info.resident_size / 1024);
+            m.peak_rss_kb = static_cast<std::size_t>(info.resident_size_max / 1024);
+        }
+        task_events_info ev{};
+        count = TASK_EVENTS_INFO_COUNT;
+        if (task_info(mach_task_self(), TASK_EVENTS_INFO,
+                      reinterpret_cast<task_info_t>(&ev), &count) == KERN_SUCCESS) {
+            std::uint64_t faults = static_cast<std::uint64_t>(ev.faults);
+            std::uint64_t pageins = static_cast<std::uint64_t>(ev.pageins);
+            m.major_faults = pageins;
+            m.minor_faults = faults > pageins ? faults - pageins : 0;
+        }
+        return m;
+    }
+
+    // resident_size_max cannot be reset; peaks are process-lifetime.
+    inline bool reset_peak_rss() { return false; }
+
+    inline std::size_t page_size() { return static_cast<std::size_t>(getpagesize()); }
+
+    inline void* reserve_pages(std::size_t bytes) {
+        void* p = mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANON, -1, 0);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    inline bool commit_pages(void* p, std::size_t bytes) {
+        return mprotect(p, bytes, PROT_READ | PROT_WRITE) == 0;
+    }
+
+    // MADV_FREE lets the kernel reclaim lazily; contents are undefined after.
+    inline void decommit_pages(void* p, std::size_t bytes) { madvise(p, bytes, MADV_FREE); }
+
+    inline void release_pages(void* p, std::size_t bytes) { munmap(p, bytes); }
+
+    // Committed pages only; read-only pages fault on any write.
+    inline bool protect_pages(void* p, std::size_t bytes, bool writable) {
+        return mprotect(p, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ) == 0;
+    }
+
+    // ============================================================
+    // Read-only file views: the whole file, mapped private and never
+    // written, so its pages are the page cache's and every process mapping
+    // the same file shares them. nullptr for a missing or empty file.
+    // ============================================================
+    inline const void* map_file(const char* path, std::size_t& bytes) {
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return nullptr;
+        struct stat st;
+        void* p = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            bytes = static_cast<std::size_t>(st.st_size);
+            p = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);   // the mapping keeps the file open
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    inline void unmap_file(const void* p, std::size_t bytes) { munmap(const_cast<void*>(p), bytes); }
+
+    // ============================================================
+    // Large pages: 2 MB superpages on x86_64, requested through mmap's fd
+    // argument and mapped in full. No THP, no 1 GB pages, none on arm64.
+    // ============================================================
+    inline std::size_t page_size(PageKind k) {
+        if (k == PageKind::Normal) return page_size();
+#if defined(VM_FLAGS_SUPERPAGE_SIZE_2MB)
+        if (k == PageKind::Huge2M) return std::size_t(2) << 20;
+#endif
+        return 0;
+    }
+
+    // `committed` is set when the range is usable without commit_pages().
+    inline void* reserve_pages(std::size_t bytes, PageKind k, bool& committed) {
+        committed = false;
+        if (k == PageKind::Normal) return reserve_pages(bytes);
+        if (!page_size(k)) return nullptr;
+#if defined(VM_FLAGS_SUPERPAGE_SIZE_2MB)
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, VM_FLAGS_SUPERPAGE_SIZE_2MB, 0);
+        if (p == MAP_FAILED) return nullptr;
+        committed = true;
+        return p;
+#else
+        return nullptr;
+#endif
+    }
+
+    inline void advise_pages(void*, std::size_t, PageKind) {}
+
+    // Bytes of [p, p + bytes) backed by physical memory right now.
+    inline std::size_t resident_bytes(const void* p, std::size_t bytes) {
+        const std::size_t page = page_size(), chunk = std::size_t(1) << 14;   // pages per mincore call
+        std::vector<char> vec(chunk);
+        std::size_t resident = 0;
+        for (std::size_t off = 0; off < bytes; off += chunk * page) {
+            std::size_t len = bytes - off < chunk * page ? bytes - off : chunk * page;
+            if (mincore(static_cast<const char*>(p) + off, len, vec.data()) != 0) return resident;
+            for (std::size_t i = 0; i < (len + page - 1) / page; ++i)
+                resident += (vec[i] & MINCORE_INCORE) ? page : 0;
+        }
+        return resident;
+    }
+
+    // ============================================================
+    // Host description for result records; "" when unknown.
+    // ============================================================
+    inline std::string host_name() {
+        char buf[256] = {};
+        return gethostname(buf, sizeof(buf) - 1) == 0 ? buf : "";
+    }
+
+    inline std::string cpu_model() {
+        char buf[256] = {};
+        std::size_t len = sizeof(buf) - 1;
+        return sysctlbyname("machdep.cpu.brand_string", buf, &len, nullptr, 0) == 0 ? buf : "";
+    }
+
+    // Frequency policy is the kernel's; there is no governor to report.
+    inline std::string cpu_governor() { return ""; }
+
+    inline unsigned sysctl_unsigned(const char* name, unsigned fallback) {
+        int v = 0;
+        std::size_t len = sizeof(v);
+        return sysctlbyname(name, &v, &len, nullptr, 0) == 0 && v > 0 ? static_cast<unsigned>(v) : fallback;
+    }
+
+    // sysctl gives counts only: logical CPUs are laid out package by
+    // package with SMT siblings adjacent, one L3 and one node per package.
+    inline bool cpu_topology(std::vector<CpuPlace>& out) {
+        unsigned logical = sysctl_unsigned("hw.logicalcpu", 0);
+        if (!logical) return false;
+        unsigned physical = sysctl_unsigned("hw.physicalcpu", logical);
+        unsigned packages = sysctl_unsigned("hw.packages", 1);
+        unsigned smt = logical / physical ? logical / physical : 1;
+        unsigned per_package = logical / packages ? logical / packages : logical;
+        for (unsigned c = 0; c < logical; ++c) {
+            CpuPlace p;
+            p.cpu = c;
+            p.package = p.node = p.l3 = c / per_package;
+            p.core = c / smt;
+            out.push_back(p);
+        }
+        return true;
+    }
+
+    // Every page is one node's; there is no placement to ask for.
+    inline bool commit_pages_on_node(void* p, std::size_t bytes, unsigned) { return commit_pages(p, bytes); }
+
+    inline bool run_with_stack(std::size_t stack_bytes, void (*fn)(void*), void* ctx) {
+        struct Call {
+            void (*fn)(void*);
+            void* ctx;
+        } call{fn, ctx};
+        pthread_attr_t attr;
+        if (pthread_attr_init(&attr) != 0) return false;
+        // macOS requires a page-multiple stack size.
+        std::size_t page = 16384;
+        stack_bytes = (stack_bytes + page - 1) / page * page;
+        pthread_t t;
+        bool ok = pthread_attr_setstacksize(&attr, stack_bytes) == 0 &&
+                  pthread_create(&t, &attr, [](void* c) -> void* {
+                      Call* k = static_cast<Call*>(c);
+                      k->fn(k->ctx);
+                      return nullptr;
+                  }, &call) == 0;
+        pthread_attr_destroy(&attr);
+        if (ok) pthread_join(t, nullptr);
+        return ok;
+    }
+
+    // XNU has no hard affinity. An affinity tag asks the scheduler to keep
+    // threads with distinct tags on distinct cores (ignored on Apple
+    // silicon), and the interactive QoS class is the closest to a
+    // priority boost.
+    inline void pin_to_core(unsigned core_index) {
+        thread_affinity_policy_data_t policy = {static_cast<integer_t>(core_index + 1)};
+        thread_policy_set(pthread_mach_thread_np(pthread_self()), THREAD_AFFINITY_POLICY,
+                          reinterpret_cast<thread_policy_t>(&policy), THREAD_AFFINITY_POLICY_COUNT);
+    }
+
+    inline void pin_to_core_and_boost(unsigned core_index = 0) {
+        pin_to_core(core_index);
+        pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
+    }
+
+    // New threads inherit the creating thread's QoS class.
+    inline void drop_boost() { pthread_set_qos_class_self_np(QOS_CLASS_DEFAULT, 0); }
+}
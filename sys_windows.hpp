@@ -0,0 +1,294 @@
+// === VGC 2.5 PPE System Backend: Windows ===
+// Link: -lpsapi (MinGW); MSVC picks psapi.lib and advapi32.lib up from the pragmas below.
+
+#pragma once
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef _WIN32_WINNT
+#define _WIN32_WINNT 0x0601   // Windows 7: processor groups, GetLogicalProcessorInformationEx
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <psapi.h>
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#pragma comment(lib, "psapi.lib")
+#pragma comment(lib, "advapi32.lib")
+#endif
+
+namespace sys {
+    inline const char* platform_name() { return "windows"; }
+
+    inline std::size_t working_set_kb() {
+        PROCESS_MEMORY_COUNTERS pmc{};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+            return static_cast<std::size_t>(pmc.WorkingSetSize / 1024);
+        return 0;
+    }
+
+    inline MemorySnapshot memory_snapshot() {
+        MemorySnapshot m;
+        PROCESS_MEMORY_COUNTERS pmc{};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+            m.rss_kb = static_cast<std::size_t>(pmc.WorkingSetSize / 1024);
+            m.peak_rss_kb = static_cast<std::size_t>(pmc.PeakWorkingSetSize / 1024);
+            m.minor_faults = pmc.PageFaultCount;
+        }
+        return m;
+    }
+
+    // PeakWorkingSetSize cannot be reset; peaks are process-lifetime.
+    inline bool reset_peak_rss() { return false; }
+
+    inline std::size_t page_size() {
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        return static_cast<std::size_t>(si.dwPageSize);
+    }
+
+    inline void* reserve_pages(std::size_t bytes) {
+        return VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS);
+    }
+
+    inline bool commit_pages(void* p, std::size_t bytes) {
+        return VirtualAlloc(p, bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+    }
+
+    // MEM_RESET discards the contents but keeps the commit charge, matching
+    // the Linux/macOS semantics (range stays usable without a new commit).
+    inline void decommit_pages(void* p, std::size_t bytes) { VirtualAlloc(p, bytes, MEM_RESET, PAGE_READWRITE); }
+
+    inline void release_pages(void* p, std::size_t) { VirtualFree(p, 0, MEM_RELEASE); }
+
+    // Committed pages only; read-only pages fault on any write.
+    inline bool protect_pages(void* p, std::size_t bytes, bool writable) {
+        DWORD old = 0;
+        return VirtualProtect(p, bytes, writable ? PAGE_READWRITE : PAGE_READONLY, &old) != 0;
+    }
+
+    // ============================================================
+    // Read-only file views: the whole file through a PAGE_READONLY mapping,
+    // so its pages are the file cache's and every process mapping the same
+    // file shares them. nullptr for a missing or empty file.
+    // ============================================================
+    inline const void* map_file(const char* path, std::size_t& bytes) {
+        HANDLE f = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                               nullptr);
+        if (f == INVALID_HANDLE_VALUE) return nullptr;
+        LARGE_INTEGER size;
+        void* p = nullptr;
+        if (GetFileSizeEx(f, &size) && size.QuadPart > 0) {
+            bytes = static_cast<std::size_t>(size.QuadPart);
+            if (HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+                p = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(m);   // the view keeps the mapping alive
+            }
+        }
+        CloseHandle(f);
+        return p;
+    }
+
+    inline void unmap_file(const void* p, std::size_t) { UnmapViewOfFile(p); }
+
+    // ============================================================
+    // Large pages: MEM_LARGE_PAGES, committed and locked in full at
+    // reservation. Needs SeLockMemoryPrivilege ("Lock pages in memory"),
+    // which is enabled here if the account holds it. No THP equivalent,
+    // and 1 GB pages are not exposed through VirtualAlloc.
+    // ============================================================
+    inline std::size_t page_size(PageKind k) {
+        if (k == PageKind::Normal) return page_size();
+        if (k == PageKind::Huge2M) return static_cast<std::size_t>(GetLargePageMinimum());
+        return 0;
+    }
+
+    inline bool enable_lock_memory_privilege() {
+        HANDLE token = nullptr;
+        if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) return false;
+        TOKEN_PRIVILEGES tp{};
+        tp.PrivilegeCount = 1;
+        tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+        bool ok = LookupPrivilegeValueA(nullptr, "SeLockMemoryPrivilege", &tp.Privileges[0].Luid) &&
+                  AdjustTokenPrivileges(token, FALSE, &tp, 0, nullptr, nullptr) &&
+                  GetLastError() == ERROR_SUCCESS;   // ERROR_NOT_ALL_ASSIGNED: not held
+        CloseHandle(token);
+        return ok;
+    }
+
+    // `committed` is set when the range is usable without commit_pages().
+    inline void* reserve_pages(std::size_t bytes, PageKind k, bool& committed) {
+        committed = false;
+        if (k == PageKind::Normal) return reserve_pages(bytes);
+        if (!page_size(k) || !enable_lock_memory_privilege()) return nullptr;
+        void* p = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        committed = p != nullptr;
+        return p;
+    }
+
+    inline void advise_pages(void*, std::size_t, PageKind) {}
+
+    // Bytes of [p, p + bytes) in the working set right now; large pages
+    // are locked, so they always count.
+    inline std::size_t resident_bytes(const void* p, std::size_t bytes) {
+        const std::size_t page = page_size(), chunk = 4096;   // pages per query
+        std::vector<PSAPI_WORKING_SET_EX_INFORMATION> info(chunk);
+        std::size_t resident = 0;
+        for (std::size_t first = 0; first < (bytes + page - 1) / page; first += chunk) {
+            std::size_t n = std::min(chunk, (bytes + page - 1) / page - first);
+            for (std::size_t i = 0; i < n; ++i)
+                info[i].VirtualAddress = const_cast<char*>(static_cast<const char*>(p)) + (first + i) * page;
+            if (!QueryWorkingSetEx(GetCurrentProcess(), info.data(), static_cast<DWORD>(n * sizeof(info[0]))))
+                return resident;
+            for (std::size_t i = 0; i < n; ++i) resident += info[i].VirtualAttributes.Valid ? page : 0;
+        }
+        return resident;
+    }
+
+    // ============================================================
+    // Host description for result records; "" when unknown.
+    // ============================================================
+    inline std::string host_name() {
+        char buf[MAX_COMPUTERNAME_LENGTH + 1] = {};
+        DWORD len = sizeof(buf);
+        return GetComputerNameA(buf, &len) ? buf : "";
+    }
+
+    inline std::string cpu_model() {
+        char buf[256] = {};
+        DWORD len = sizeof(buf);
+        if (RegGetValueA(HKEY_LOCAL_MACHINE, "HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0",
+                         "ProcessorNameString", RRF_RT_REG_SZ, nullptr, buf, &len) != ERROR_SUCCESS)
+            return "";
+        return buf;
+    }
+
+    // Power plans are not a per-core governor; left blank.
+    inline std::string cpu_governor() { return ""; }
+
+    // ============================================================
+    // Processor groups: Windows numbers CPUs per group of up to 64, so a
+    // flat CPU id is the group's base (the sizes of the groups before it)
+    // plus the bit within the group's affinity mask.
+    // ============================================================
+    inline unsigned group_base(WORD group) {
+        unsigned base = 0;
+        for (WORD g = 0; g < group; ++g) base += GetMaximumProcessorCount(g);
+        return base;
+    }
+
+    inline bool cpu_group(unsigned cpu, GROUP_AFFINITY& out) {
+        WORD groups = GetActiveProcessorGroupCount();
+        for (WORD g = 0; g < groups; ++g) {
+            unsigned n = GetMaximumProcessorCount(g);
+            if (cpu < n) {
+                out = GROUP_AFFINITY{};
+                out.Group = g;
+                out.Mask = static_cast<KAFFINITY>(1) << cpu;
+                return true;
+            }
+            cpu -= n;
+        }
+        return false;
+    }
+
+    template <class Fn>
+    inline void for_each_cpu(const GROUP_AFFINITY& ga, Fn&& fn) {
+        unsigned base = group_base(ga.Group);
+        for (unsigned bit = 0; bit < 8 * sizeof(KAFFINITY); ++bit)
+            if ((ga.Mask >> bit) & 1) fn(base + bit);
+    }
+
+    inline bool cpu_topology(std::vector<CpuPlace>& out) {
+        DWORD len = 0;
+        GetLogicalProcessorInformationEx(RelationAll, nullptr, &len);
+        std::vector<char> buf(len);
+        auto* first = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buf.data());
+        if (!len || !GetLogicalProcessorInformationEx(RelationAll, first, &len)) return false;
+
+        auto place = [&](unsigned cpu) -> CpuPlace& {
+            for (CpuPlace& p : out)
+                if (p.cpu == cpu) return p;
+            out.push_back(CpuPlace{});
+            out.back().cpu = cpu;
+            return out.back();
+        };
+        unsigned cores = 0, packages = 0, l3s = 0;
+        for (DWORD at = 0; at < len;) {
+            auto* e = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buf.data() + at);
+            switch (e->Relationship) {
+                case RelationProcessorCore:
+                    for (WORD g = 0; g < e->Processor.GroupCount; ++g)
+                        for_each_cpu(e->Processor.GroupMask[g], [&](unsigned c) { place(c).core = cores; });
+                    ++cores;
+                    break;
+                case RelationProcessorPackage:
+                    for (WORD g = 0; g < e->Processor.GroupCount; ++g)
+                        for_each_cpu(e->Processor.GroupMask[g], [&](unsigned c) { place(c).package = packages; });
+                    ++packages;
+                    break;
+                case RelationNumaNode:
+                    for_each_cpu(e->NumaNode.GroupMask, [&](unsigned c) { place(c).node = e->NumaNode.NodeNumber; });
+                    break;
+                case RelationCache:
+                    if (e->Cache.Level == 3) {
+                        for_each_cpu(e->Cache.GroupMask, [&](unsigned c) { place(c).l3 = l3s; });
+                        ++l3s;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            at += e->Size;
+        }
+        return !out.empty();
+    }
+
+    inline bool commit_pages_on_node(void* p, std::size_t bytes, unsigned node) {
+        return VirtualAllocExNuma(GetCurrentProcess(), p, bytes, MEM_COMMIT, PAGE_READWRITE, node) != nullptr;
+    }
+
+    struct StackCall {
+        void (*fn)(void*);
+        void* ctx;
+    };
+
+    inline DWORD WINAPI stack_call_main(LPVOID c) {
+        StackCall* k = static_cast<StackCall*>(c);
+        k->fn(k->ctx);
+        return 0;
+    }
+
+    // STACK_SIZE_PARAM_IS_A_RESERVATION reserves the full size up front and
+    // commits pages as the guard page is hit, like a native deep recursion.
+    inline bool run_with_stack(std::size_t stack_bytes, void (*fn)(void*), void* ctx) {
+        StackCall call{fn, ctx};
+        HANDLE t = CreateThread(nullptr, stack_bytes, stack_call_main, &call,
+                                STACK_SIZE_PARAM_IS_A_RESERVATION, nullptr);
+        if (!t) return false;
+        WaitForSingleObject(t, INFINITE);
+        CloseHandle(t);
+        return true;
+    }
+
+    // Group affinity, so CPUs past the first 64 (and past group 0) work.
+    inline void pin_to_core(unsigned core_index) {
+        GROUP_AFFINITY ga;
+        if (cpu_group(core_index, ga)) SetThreadGroupAffinity(GetCurrentThread(), &ga, nullptr);
+    }
+
+    inline void pin_to_core_and_boost(unsigned core_index = 0) {
+        pin_to_core(core_index);
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+    }
+
+    // Windows threads start at normal priority; this only makes it explicit.
+    inline void drop_boost() { SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_NORMAL); }
+}
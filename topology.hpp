@@ -0,0 +1,152 @@
+// === VGC 2.5 PPE CPU Topology and Pinning Policies ===
+// Packages, NUMA nodes, cores, SMT siblings and L3 domains, and thread placement over them.
+
+#pragma once
+
+#include "sys.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace sys {
+    // ============================================================
+    // Topology: the CPUs this process may use, in id order. `smt` is a
+    // CPU's rank among the siblings of its core (0 = first thread).
+    // Without a backend answer every CPU is its own core on one node.
+    // ============================================================
+    struct Topology {
+        struct Cpu : CpuPlace {
+            unsigned smt = 0;
+        };
+        std::vector<Cpu> cpus;
+        unsigned packages = 1, nodes = 1, cores = 1, l3_domains = 1;
+
+        const Cpu* find(unsigned cpu) const {
+            for (const Cpu& c : cpus)
+                if (c.cpu == cpu) return &c;
+            return nullptr;
+        }
+        unsigned node_of(unsigned cpu) const {
+            const Cpu* c = find(cpu);
+            return c ? c->node : 0;
+        }
+        unsigned threads_per_core() const { return cores ? static_cast<unsigned>(cpus.size()) / cores : 1; }
+    };
+
+    template <class Key>
+    inline unsigned count_distinct(const std::vector<Topology::Cpu>& cpus, Key key) {
+        std::vector<decltype(key(cpus.front()))> seen;
+        for (const Topology::Cpu& c : cpus)
+            if (std::find(seen.begin(), seen.end(), key(c)) == seen.end()) seen.push_back(key(c));
+        return static_cast<unsigned>(seen.size());
+    }
+
+    inline Topology discover_topology() {
+        Topology t;
+        std::vector<CpuPlace> raw;
+        if (!cpu_topology(raw)) {
+            raw.clear();
+            unsigned n = std::thread::hardware_concurrency();
+            for (unsigned c = 0; c < (n ? n : 1); ++c) {
+                CpuPlace p;
+                p.cpu = p.core = c;
+                raw.push_back(p);
+            }
+        }
+        std::sort(raw.begin(), raw.end(), [](const CpuPlace& a, const CpuPlace& b) { return a.cpu < b.cpu; });
+        for (const CpuPlace& p : raw) {
+            Topology::Cpu c;
+            static_cast<CpuPlace&>(c) = p;
+            for (const Topology::Cpu& prev : t.cpus)
+                if (prev.package == p.package && prev.core == p.core) ++c.smt;
+            t.cpus.push_back(c);
+        }
+        t.packages = count_distinct(t.cpus, [](const Topology::Cpu& c) { return c.package; });
+        t.nodes = count_distinct(t.cpus, [](const Topology::Cpu& c) { return c.node; });
+        t.cores = count_distinct(t.cpus, [](const Topology::Cpu& c) { return std::make_pair(c.package, c.core); });
+        t.l3_domains = count_distinct(t.cpus, [](const Topology::Cpu& c) { return c.l3; });
+        return t;
+    }
+
+    // Discovered once; the process's affinity does not change under us.
+    inline const Topology& topology() {
+        static const Topology t = discover_topology();
+        return t;
+    }
+
+    // ============================================================
+    // Pinning policies: the CPU for each worker index.
+    //
+    //   compact   fill a core's SMT siblings, then the next core of the
+    //             same L3 and node, then the next node. Threads share
+    //             caches; bandwidth stays on one node as long as it can
+    //   scatter   one core per node in turn, first threads of cores
+    //             before siblings. Spreads bandwidth and L3 across nodes
+    //   physical  one thread per physical core in compact order; siblings
+    //             only once every core has one
+    //
+    // More workers than CPUs wrap around.
+    // ============================================================
+    enum class PinPolicy : unsigned char { Compact, Scatter, Physical };
+
+    struct PinPolicyName {
+        PinPolicy policy;
+        const char* name;
+    };
+
+    constexpr PinPolicyName kPinPolicies[] = {
+        {PinPolicy::Compact, "compact"}, {PinPolicy::Scatter, "scatter"}, {PinPolicy::Physical, "physical"}};
+
+    inline const char* pin_policy_name(PinPolicy p) {
+        for (const PinPolicyName& n : kPinPolicies)
+            if (n.policy == p) return n.name;
+        return "?";
+    }
+
+    inline bool find_pin_policy(const char* name, PinPolicy& out) {
+        for (const PinPolicyName& n : kPinPolicies)
+            if (!std::strcmp(n.name, name)) {
+                out = n.policy;
+                return true;
+            }
+        return false;
+    }
+
+    inline std::vector<unsigned> placement(const Topology& t, PinPolicy policy, unsigned threads) {
+        using Cpu = Topology::Cpu;
+        std::vector<Cpu> order = t.cpus;
+        auto compact = [](const Cpu& c) { return std::make_tuple(c.node, c.package, c.l3, c.core, c.smt); };
+        std::stable_sort(order.begin(), order.end(),
+                         [&](const Cpu& a, const Cpu& b) { return compact(a) < compact(b); });
+
+        if (policy == PinPolicy::Physical) {
+            std::stable_sort(order.begin(), order.end(),
+                             [](const Cpu& a, const Cpu& b) { return (a.smt > 0) < (b.smt > 0); });
+        } else if (policy == PinPolicy::Scatter) {
+            // Rank each CPU among the same-sibling-rank CPUs of its node, in
+            // compact order, then deal ranks out node by node.
+            std::vector<unsigned> rank(order.size());
+            for (std::size_t i = 0; i < order.size(); ++i)
+                for (std::size_t j = 0; j < i; ++j)
+                    if (order[j].node == order[i].node && order[j].smt == order[i].smt) ++rank[i];
+            std::vector<std::size_t> idx(order.size());
+            for (std::size_t i = 0; i < idx.size(); ++i) idx[i] = i;
+            std::stable_sort(idx.begin(), idx.end(), [&](std::size_t a, std::size_t b) {
+                return std::make_tuple(order[a].smt, rank[a], order[a].node) <
+                       std::make_tuple(order[b].smt, rank[b], order[b].node);
+            });
+            std::vector<Cpu> dealt;
+            for (std::size_t i : idx) dealt.push_back(order[i]);
+            order.swap(dealt);
+        }
+
+        std::vector<unsigned> cpus(threads ? threads : 1);
+        for (std::size_t i = 0; i < cpus.size(); ++i) cpus[i] = order[i % order.size()].cpu;
+        return cpus;
+    }
+}
@@ -0,0 +1,1783 @@
+// === VGC 2.5 PPE Benchmark Harness (Workload Registry, N Sweeps, Short Checksum) ===
+// Compile: g++ -O3 -std=c++17 vgc_bench.cpp -lpsapi -o vgc_bench.exe   (Windows)
+//          g++ -O3 -std=c++17 vgc_bench.cpp -pthread -o vgc_bench       (Linux, macOS)
+//          -std=c++20 adds the coroutine workloads (coroutines.hpp).
+//          -DVGC_BUILD_FLAGS='"-O3 -std=c++17"' records the exact flags (report.hpp).
+// No -march=native: SIMD kernels are picked at runtime (see simd.hpp).
+//
+// Usage:
+//   vgc_bench                                  every workload at its default sizes (loop_chunk 100K/200K/400K, ...)
+//   vgc_bench --workload loop_chunk --n 1M     single run
+//   vgc_bench --sweep 10k:100M:2               geometric sweep over N (lo:hi[:factor])
+//   vgc_bench --list                           show registered workloads
+//   vgc_bench --samples 31 --sample-ms 20      more / longer timed samples
+//   vgc_bench --warmup 0 --samples 1 --sample-ms 0   single cold call (legacy timing)
+//   vgc_bench --no-counters                    skip perf_event counters (TSC is always read)
+//   vgc_bench --mem-sample-ms 1                record an RSS timeline on a sampler thread
+//   vgc_bench --workload loop_partitioned --threads sweep   speedup/efficiency over 1..all cores
+//   vgc_bench --workload recursive_stealing --chunk 250     work-stealing over recursion chunks
+//   vgc_bench --workload loop_simd --kernel all             every SIMD kernel this CPU supports
+//   vgc_bench --workload loop_closed_form --sweep 1k:1G:10  O(1) floor next to the iterative kernel
+//   vgc_bench --workload lambda_simd --lambda all           engine kernels against hand-written loop_chunk
+//   vgc_bench --workload recursive_trampoline --n 10M --chunk 1k,100k,1M   depth cost curve
+//   vgc_bench --workload recursive_driver --chunk 1k,16k                   stack probe: did it recurse?
+//   vgc_bench --workload zone_long_graph --n 10M --zone-mb 1024            R/G/B zone allocator
+//   vgc_bench --workload bitfield_sweep --sweep 1M:100M:10 --gate and_not  liveness sweep vs headers
+//   vgc_bench --workload zone_chunk_batch --chunk 100,1k,10k               batch alloc + O(1) chunk release
+//   vgc_bench --workload yield_loop_temp --n 10M                          Yield Memory temporaries
+//   vgc_bench --workload gc_parallel --threads sweep                       mutators + parallel collection
+//   vgc_bench --workload zone_mixed_lifetime --heap all                    zones vs malloc, refcounting, GC
+//   vgc_bench --json results.jsonl --csv results.csv                       machine-readable records per run
+//   vgc_bench --baseline save   then   vgc_bench --baseline check         exit 2 on a regression, 3 on a mismatch
+//   vgc_bench --topology                                                   sockets, nodes, cores, SMT, L3
+//   vgc_bench --workload gc_parallel --threads sweep --pin scatter --zone-node local   NUMA placement
+//   vgc_bench --workload bitfield_sweep --zone-pages thp --prefault        large pages, no first-touch faults
+//   vgc_bench --workload bitfield_sweep --sweep 1M:100M:10 --link-gbps 25  offload bound and crossover
+//   vgc_bench --workload gc_layered --slice-slots 64k --slice-us 100       incremental sweep, tail pauses
+//   vgc_bench --workload gc_generational --survival 1,10,50 --promote-after 2   promotion cost
+//   vgc_bench --workload interp_isolated --threads sweep --zone-node local   one interpreter per core
+//   vgc_bench --workload snapshot_map --n 1M --snapshot constants.snap       mapped vs rebuilt constant heap
+//   vgc_bench --workload recursive_coroutine --workload recursive_coroutine_heap   zone vs heap frames (C++20)
+
+#include "baselines.hpp"
+#include "bitfield.hpp"
+#include "closed_form.hpp"
+#include "collector.hpp"
+#include "coroutines.hpp"
+#include "deep_recursion.hpp"
+#include "engine.hpp"
+#include "generations.hpp"
+#include "interpreters.hpp"
+#include "layered.hpp"
+#include "measure.hpp"
+#include "memory.hpp"
+#include "offload.hpp"
+#include "parallel.hpp"
+#include "regress.hpp"
+#include "report.hpp"
+#include "scheduler.hpp"
+#include "simd.hpp"
+#include "snapshot.hpp"
+#include "stack_probe.hpp"
+#include "sweep_workloads.hpp"
+#include "sys.hpp"
+#include "topology.hpp"
+#include "workloads.hpp"
+#include "yield_memory.hpp"
+#include "zone.hpp"
+#include "zone_workloads.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// ============================================================
+// Timed-region tripwires (see sys::count_allocation). Every plain global
+// allocation is counted, in a per-thread slot without a shared atomic, so
+// the baseline heaps that allocate per object are not skewed by it; the
+// over-aligned forms keep the library's own aligned allocator and go
+// uncounted. -DVGC_NO_ALLOC_COUNT keeps the library operator new.
+// GCC pairs the inlined free() with its built-in operator new and warns.
+// ============================================================
+#if !defined(VGC_NO_ALLOC_COUNT)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(std::size_t bytes, const std::nothrow_t&) noexcept {
+    sys::count_allocation();
+    return std::malloc(bytes ? bytes : 1);
+}
+void* operator new(std::size_t bytes) {
+    if (void* p = operator new(bytes, std::nothrow)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t bytes) { return operator new(bytes); }
+void* operator new[](std::size_t bytes, const std::nothrow_t&) noexcept { return operator new(bytes, std::nothrow); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+// Forwards to the stream's own buffer and counts sys::console_bytes.
+class ConsoleTap : public std::streambuf {
+public:
+    explicit ConsoleTap(std::ostream& os) : os_(os), to_(os.rdbuf(this)) {}
+    ConsoleTap(const ConsoleTap&) = delete;
+    ConsoleTap& operator=(const ConsoleTap&) = delete;
+    ~ConsoleTap() override { os_.rdbuf(to_); }
+
+protected:
+    int_type overflow(int_type c) override {
+        if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+        sys::console_bytes.fetch_add(1, std::memory_order_relaxed);
+        return to_->sputc(traits_type::to_char_type(c));
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        sys::console_bytes.fetch_add(static_cast<std::uint64_t>(n), std::memory_order_relaxed);
+        return to_->sputn(s, n);
+    }
+    int sync() override { return to_->pubsync(); }
+
+private:
+    std::ostream& os_;
+    std::streambuf* to_;
+};
+
+// ============================================================
+// Workload registry
+// ============================================================
+struct Params {
+    std::size_t n = 0;
+    int chunk_size = 1000;
+    sys::WorkerPool* pool = nullptr;   // set for parallel workloads
+    sys::PerThread<short>* partials = nullptr;   // set for loop_partitioned
+    sys::ChunkScheduler* sched = nullptr;
+    const simd::LoopKernel* kernel = nullptr;   // set for kKernel workloads
+    const engine::KernelEntry* lambda = nullptr;   // set for kLambda workloads
+    deep::ExplicitStack* frames = nullptr;
+    vgc::ZoneSet* zones = nullptr;     // set for kZone workloads
+    vgc::SweepHeap* heap = nullptr;    // set for kSweep workloads
+    vgc::Gate gate = vgc::Gate::AndNot;
+    const vgc::SweepKernel* sweep_kernel = nullptr;   // set for bitfield_sweep
+    vgc::OffloadBound offload;                        // --link-gbps / --offload-us, for bitfield_sweep
+    vgc::YieldCache* yield = nullptr;  // set for kYield workloads
+    vgc::ParallelCollector* collector = nullptr;
+    vgc::LayeredHeap* layers = nullptr;   // set for gc_layered / gc_single_layer
+    vgc::GenerationalHeap* generations = nullptr;   // set for gc_generational
+    unsigned survival_pct = 10;                     // --survival, share of objects that outlive the nursery
+    vgc::InterpreterSet* interpreters = nullptr;    // set for interp_isolated
+    vgc::Bitfield* live = nullptr;                  // set for zone_chunk_batch / zone_chunk_objects
+    baseline::GraphTable* graph = nullptr;          // set for zone_long_graph
+    vgc::ConstantSnapshot* snapshot = nullptr;      // set for snapshot_rebuild / snapshot_map
+#if defined(VGC_HAS_COROUTINES)
+    deep::CoroutineDriver<deep::ZoneFrames>* coro_zone = nullptr;   // set for recursive_coroutine
+    deep::CoroutineDriver<deep::HeapFrames>* coro_heap = nullptr;   // set for recursive_coroutine_heap
+#endif
+    baseline::Heap manager = baseline::Heap::Zone;   // --heap, for kHeap workloads
+};
+
+enum WorkloadFlags : unsigned {
+    kChunked = 1u << 0,    // honours --chunk (recursion depth per chunk)
+    kParallel = 1u << 1,   // runs on the worker pool, honours --threads
+    kKernel = 1u << 2,     // runs a dispatched loop kernel, honours --kernel
+    kBigStack = 1u << 3,   // measured on a thread whose stack fits native recursion at --chunk depth
+    kZone = 1u << 4,       // allocates from the R/G/B zones, honours --zone-mb
+    kSweep = 1u << 5,      // sweeps an N-slot heap, honours --gate
+    kYield = 1u << 6,      // allocates temporaries from the Red zone, through Yield Memory or its lock
+    kHeap = 1u << 7,       // honours --heap (the zones, or a baseline memory manager)
+    kLambda = 1u << 8,     // runs a registered engine kernel on one backend, honours --lambda
+    kRecursive = 1u << 9,  // runs recursive_chunk's recursion on the calling thread, gets a stack probe
+    kLayered = 1u << 10,   // gc_layered's heap: a frozen passive layer under the collected one
+};
+
+struct Workload {
+    const char* name;
+    const char* title;      // banner name, e.g. "PPE Loop Benchmark"
+    const char* n_label;    // how the original banner labelled N
+    const char* section;    // result section header
+    unsigned flags;         // WorkloadFlags
+    std::size_t default_sizes[3];
+    short (*run)(const Params&);
+    short (*serial_ref)(const Params&);   // optional single-thread reference for overhead
+    short (*oracle)(const Params&);       // optional O(1) expected checksum
+};
+
+static short run_loop_chunk(const Params& p) { return loop_chunk(0, p.n); }
+static short run_recursive_driver(const Params& p) { return recursive_driver(p.n, p.chunk_size); }
+static short run_loop_partitioned(const Params& p) { return partitioned_loop(*p.pool, *p.partials, p.n); }
+static short run_recursive_stealing(const Params& p) { return p.sched->run_recursive(p.n, p.chunk_size); }
+static short run_loop_simd(const Params& p) { return p.kernel->fn(0, p.n); }
+static short run_loop_closed_form(const Params& p) { return closed_form::loop(0, p.n); }
+static short run_lambda(const Params& p, engine::Backend b) {
+    return p.lambda->run[b](engine::Resources{p.pool, p.partials, p.sched}, p.n);
+}
+static short run_lambda_serial(const Params& p) { return run_lambda(p, engine::kSerial); }
+static short run_lambda_partitioned(const Params& p) { return run_lambda(p, engine::kPartitioned); }
+static short run_lambda_simd(const Params& p) { return run_lambda(p, engine::kSimd); }
+static short run_lambda_stealing(const Params& p) { return run_lambda(p, engine::kStealing); }
+static short run_loop_constexpr(const Params& p) { return closed_form::loop_constexpr(p.n); }
+static short run_recursive_closed_form(const Params& p) { return closed_form::recursive_driver(p.n, p.chunk_size); }
+static short run_recursive_constexpr(const Params& p) { return closed_form::recursive_constexpr(p.n, p.chunk_size); }
+static short run_recursive_trampoline(const Params& p) { return deep::trampoline_driver(p.n, p.chunk_size); }
+static short run_recursive_explicit(const Params& p) { return p.frames->driver(p.n, p.chunk_size); }
+static short run_zone_small_churn(const Params& p) { return baseline::small_churn(p.manager, p.zones->red, p.n); }
+static short run_zone_mixed_lifetime(const Params& p) {
+    return baseline::mixed_lifetime(p.manager, p.zones->green, p.n);
+}
+static short run_zone_long_graph(const Params& p) {
+    return baseline::long_graph(p.manager, p.zones->blue, p.n, *p.graph);
+}
+static short run_zone_chunk_batch(const Params& p) {
+    return vgc::chunk_nodes<true>(p.zones->red, *p.live, p.n, p.chunk_size);
+}
+static short run_zone_chunk_objects(const Params& p) {
+    return vgc::chunk_nodes<false>(p.zones->red, *p.live, p.n, p.chunk_size);
+}
+static short run_bitfield_sweep(const Params& p) {
+    return vgc::bitfield_sweep(*p.heap, p.n, p.gate, *p.sweep_kernel);
+}
+static short run_header_sweep(const Params& p) { return vgc::header_sweep(*p.heap, p.n, p.gate); }
+static short run_yield_loop_temp(const Params& p) {
+    p.yield->reset_stats();
+    return vgc::loop_with_temporaries(*p.yield, p.n);
+}
+static short run_zone_loop_temp(const Params& p) {
+    vgc::LockedZone z{p.yield->zone()};
+    return vgc::loop_with_temporaries(z, p.n);
+}
+static short run_gc_parallel(const Params& p) { return p.collector->run(p.n); }
+static short run_gc_layered(const Params& p) { return p.layers->run(p.n); }
+static short run_gc_generational(const Params& p) { return p.generations->run(p.n, p.survival_pct); }
+static short run_interp_isolated(const Params& p) { return p.interpreters->run(p.n, p.chunk_size); }
+static short run_snapshot_rebuild(const Params& p) { return p.snapshot->rebuild(p.n); }
+static short run_snapshot_map(const Params& p) { return p.snapshot->map(p.n); }
+#if defined(VGC_HAS_COROUTINES)
+static short run_recursive_coroutine(const Params& p) { return p.coro_zone->run(p.n, p.chunk_size); }
+static short run_recursive_coroutine_heap(const Params& p) { return p.coro_heap->run(p.n, p.chunk_size); }
+#endif
+// Per context: loop, recursion, and two allocation phases that checksum like the loop.
+static short interp_oracle(const Params& p) {
+    short script = static_cast<short>(3 * closed_form::loop(0, p.n) + closed_form::recursive_driver(p.n, p.chunk_size));
+    return static_cast<short>(script * static_cast<int>(p.pool->size()));
+}
+// Each constant's value plus its predecessor's.
+static short snapshot_oracle(const Params& p) {
+    return static_cast<short>(closed_form::loop(0, p.n) + closed_form::loop(0, p.n ? p.n - 1 : 0));
+}
+
+static const Workload kWorkloads[] = {
+    {"loop_chunk", "PPE Loop Benchmark", "Workload N", "[Loop Partition]", 0,
+     {100000, 200000, 400000}, run_loop_chunk, nullptr, run_loop_closed_form},
+    {"recursive_driver", "PPE Recursion Benchmark", "Logical Steps", "[Recursion Execution]",
+     kChunked | kRecursive, {10000, 20000, 40000}, run_recursive_driver, nullptr, run_recursive_closed_form},
+    {"loop_partitioned", "PPE Loop Benchmark", "Workload N", "[Loop Partitions]", kParallel,
+     {1000000, 10000000, 100000000}, run_loop_partitioned, run_loop_chunk, run_loop_closed_form},
+    {"recursive_stealing", "PPE Recursion Benchmark", "Logical Steps", "[Work-Stealing Execution]",
+     kChunked | kParallel, {1000000, 10000000, 100000000}, run_recursive_stealing, run_recursive_driver,
+     run_recursive_closed_form},
+    {"loop_simd", "PPE SIMD Loop Benchmark", "Workload N", "[SIMD Loop]", kKernel,
+     {1000000, 10000000, 100000000}, run_loop_simd, run_loop_chunk, run_loop_closed_form},
+    // Engine: a registered kernel (--lambda) on each range-executor backend, against hand-written loop_chunk.
+    {"lambda_serial", "PPE Lambda Engine Benchmark (Serial)", "Workload N", "[Lambda Engine, Serial]", kLambda,
+     {1000000, 10000000, 100000000}, run_lambda_serial, run_loop_chunk, run_loop_closed_form},
+    {"lambda_partitioned", "PPE Lambda Engine Benchmark (Partitioned)", "Workload N",
+     "[Lambda Engine, Partitioned]", kLambda | kParallel, {1000000, 10000000, 100000000}, run_lambda_partitioned,
+     run_loop_chunk, run_loop_closed_form},
+    {"lambda_simd", "PPE Lambda Engine Benchmark (SIMD)", "Workload N", "[Lambda Engine, SIMD]", kLambda,
+     {1000000, 10000000, 100000000}, run_lambda_simd, run_loop_chunk, run_loop_closed_form},
+    {"lambda_stealing", "PPE Lambda Engine Benchmark (Work-Stealing)", "Workload N", "[Lambda Engine, Stealing]",
+     kLambda | kParallel, {1000000, 10000000, 100000000}, run_lambda_stealing, run_loop_chunk,
+     run_loop_closed_form},
+    // Floors: what remains once the work is folded to a formula or a constant.
+    {"loop_closed_form", "PPE Loop Floor (Closed Form)", "Workload N", "[Closed Form]", 0,
+     {100000, 200000, 400000}, run_loop_closed_form, run_loop_chunk, nullptr},
+    {"loop_constexpr", "PPE Loop Floor (Compile-Time)", "Workload N", "[Compile-Time Constant]", 0,
+     {100000, 200000, 400000}, run_loop_constexpr, run_loop_chunk, nullptr},
+    {"recursive_closed_form", "PPE Recursion Floor (Closed Form)", "Logical Steps", "[Closed Form]", kChunked,
+     {10000, 20000, 40000}, run_recursive_closed_form, run_recursive_driver, nullptr},
+    {"recursive_constexpr", "PPE Recursion Floor (Compile-Time)", "Logical Steps", "[Compile-Time Constant]",
+     kChunked, {10000, 20000, 40000}, run_recursive_constexpr, run_recursive_driver, nullptr},
+    // Deep recursion: compare with native recursive_driver at the same --chunk depth.
+    {"recursive_native_deep", "PPE Deep Recursion Benchmark (Native Stack)", "Logical Steps",
+     "[Native Recursion]", kChunked | kBigStack | kRecursive, {1000000, 10000000, 100000000}, run_recursive_driver,
+     nullptr, run_recursive_closed_form},
+    {"recursive_trampoline", "PPE Deep Recursion Benchmark (Trampoline)", "Logical Steps", "[Trampoline]",
+     kChunked | kBigStack | kRecursive, {1000000, 10000000, 100000000}, run_recursive_trampoline, run_recursive_driver,
+     run_recursive_closed_form},
+    {"recursive_explicit_stack", "PPE Deep Recursion Benchmark (Explicit Stack)", "Logical Steps",
+     "[Explicit Stack]", kChunked | kBigStack | kRecursive, {1000000, 10000000, 100000000},
+     run_recursive_explicit, run_recursive_driver, run_recursive_closed_form},
+#if defined(VGC_HAS_COROUTINES)
+    // Coroutines (-std=c++20): a frame per chunk, 64 in flight, against native recursive_driver.
+    {"recursive_coroutine", "PPE Coroutine Recursion Benchmark (Zone Frames)", "Logical Steps",
+     "[Coroutine Chunks, Zone Frames]", kChunked | kZone | kRecursive, {1000000, 10000000, 100000000},
+     run_recursive_coroutine, run_recursive_driver, run_recursive_closed_form},
+    {"recursive_coroutine_heap", "PPE Coroutine Recursion Benchmark (Heap Frames)", "Logical Steps",
+     "[Coroutine Chunks, Heap Frames]", kChunked | kRecursive, {1000000, 10000000, 100000000},
+     run_recursive_coroutine_heap, run_recursive_driver, run_recursive_closed_form},
+#endif
+    // Allocation: N objects each, one zone per lifetime pattern.
+    {"zone_small_churn", "PPE Zone Benchmark (Red, Short-Lived)", "Objects", "[Red Zone]", kZone | kHeap,
+     {100000, 1000000, 10000000}, run_zone_small_churn, nullptr, run_loop_closed_form},
+    {"zone_mixed_lifetime", "PPE Zone Benchmark (Green, Mixed Lifetimes)", "Objects", "[Green Zone]", kZone | kHeap,
+     {100000, 1000000, 10000000}, run_zone_mixed_lifetime, nullptr, run_loop_closed_form},
+    {"zone_long_graph", "PPE Zone Benchmark (Blue, Long-Lived Graph)", "Objects", "[Blue Zone]", kZone | kHeap,
+     {100000, 1000000, 10000000}, run_zone_long_graph, nullptr, run_loop_closed_form},
+    // Chunks: --chunk nodes built and released together, batched or node by node.
+    {"zone_chunk_batch", "PPE Zone Chunk Benchmark (Batch Alloc, Bulk Free)", "Nodes", "[Batched Chunks]",
+     kChunked | kZone, {1000000, 10000000, 100000000}, run_zone_chunk_batch, run_zone_chunk_objects,
+     run_loop_closed_form},
+    {"zone_chunk_objects", "PPE Zone Chunk Benchmark (Per-Object Alloc/Free)", "Nodes", "[Per-Object Chunks]",
+     kChunked | kZone, {1000000, 10000000, 100000000}, run_zone_chunk_objects, nullptr, run_loop_closed_form},
+    // Liveness: one sweep of N slots, bitfield gates vs per-object headers.
+    {"bitfield_sweep", "PPE Liveness Sweep (Checkpoint Bitfield)", "Heap Slots", "[Bitfield Sweep]", kSweep,
+     {1000000, 10000000, 100000000}, run_bitfield_sweep, run_header_sweep, nullptr},
+    {"header_sweep", "PPE Liveness Sweep (Object Headers)", "Heap Slots", "[Header Sweep]", kSweep,
+     {1000000, 10000000, 100000000}, run_header_sweep, nullptr, nullptr},
+    // Temporaries in the hot loop; overhead is per step against plain loop_chunk.
+    {"yield_loop_temp", "PPE Yield Memory Benchmark (Thread-Local Cache)", "Workload N", "[Yield Memory]",
+     kYield, {1000000, 10000000, 100000000}, run_yield_loop_temp, run_loop_chunk, run_loop_closed_form},
+    {"zone_loop_temp", "PPE Yield Memory Benchmark (Locked Zone)", "Workload N", "[Locked Zone]", kYield,
+     {1000000, 10000000, 100000000}, run_zone_loop_temp, run_loop_chunk, run_loop_closed_form},
+    // Collection: N objects allocated by all mutators, collected on all of them.
+    {"gc_parallel", "PPE Parallel Collection Benchmark (Green Zone)", "Objects", "[Parallel Collection]",
+     kZone | kParallel, {1000000, 10000000, 100000000}, run_gc_parallel, nullptr, run_loop_closed_form},
+    // Layering: 60% of the live heap is startup constants, frozen in a passive zone or collected with the rest.
+    {"gc_layered", "PPE Layered Collection Benchmark (Passive + Active)", "Objects", "[Active-Passive Layers]",
+     kLayered, {1000000, 10000000, 100000000}, run_gc_layered, nullptr, run_loop_closed_form},
+    {"gc_single_layer", "PPE Layered Collection Benchmark (Single Layer)", "Objects", "[Single Layer]", 0,
+     {1000000, 10000000, 100000000}, run_gc_layered, nullptr, run_loop_closed_form},
+    // Generations: survivors of --promote-after checkpoints move Red -> Green -> Blue, one run per --survival.
+    {"gc_generational", "PPE Generational Collection Benchmark (Red -> Green -> Blue)", "Objects",
+     "[Generational Promotion]", 0, {1000000, 10000000, 100000000}, run_gc_generational, nullptr,
+     run_loop_closed_form},
+    // Isolation: one interpreter-like context per pinned thread, each with its own zone set and Yield Memory.
+    {"interp_isolated", "PPE Multi-Interpreter Benchmark (Zone Set per Context)", "Steps per Phase",
+     "[Isolated Interpreters]", kChunked | kParallel, {100000, 1000000, 10000000}, run_interp_isolated, nullptr,
+     interp_oracle},
+    // Startup: N linked constants rebuilt into a frozen zone, or mapped from the snapshot written before the runs.
+    {"snapshot_rebuild", "PPE Startup Benchmark (Rebuilt Constant Heap)", "Constants", "[Rebuild + Freeze]", 0,
+     {10000, 100000, 1000000}, run_snapshot_rebuild, nullptr, snapshot_oracle},
+    {"snapshot_map", "PPE Startup Benchmark (Mapped Snapshot)", "Constants", "[Mapped Snapshot]", 0,
+     {10000, 100000, 1000000}, run_snapshot_map, nullptr, snapshot_oracle},
+};
+
+static const Workload* find_workload(const std::string& name) {
+    for (const Workload& w : kWorkloads)
+        if (name == w.name) return &w;
+    return nullptr;
+}
+
+// ============================================================
+// Command line
+// ============================================================
+struct Options {
+    std::vector<const Workload*> workloads;
+    std::vector<std::size_t> sizes;   // empty -> default sizes per workload
+    std::vector<int> chunk_sizes;     // empty -> 1000
+    sys::MeasureConfig measure;
+    double mem_sample_ms = 0;         // 0 -> no background sampler
+    std::vector<unsigned> threads;    // empty -> all cores (parallel workloads only)
+    std::vector<const simd::LoopKernel*> kernels;   // empty -> best supported
+    std::vector<const engine::KernelEntry*> lambdas;   // empty -> loop_term (kLambda workloads)
+    std::size_t zone_mb = 4096;       // address space reserved per zone
+    vgc::Gate gate = vgc::Gate::AndNot;
+    std::vector<const vgc::SweepKernel*> sweep_kernels;   // empty -> best supported
+    std::vector<baseline::Heap> managers;                 // empty -> zone
+    std::string json_path, csv_path;                      // empty -> console only
+    report::BaselineMode baseline = report::BaselineMode::Off;
+    std::string baseline_dir = "baselines";
+    double threshold_pct = 5.0;                           // smallest growth counted as a regression
+    double alpha = 0.01;                                  // Mann-Whitney significance level for time
+    sys::PinPolicy pin = sys::PinPolicy::Physical;        // worker placement
+    int zone_node = -1;                                   // -1 -> first touch
+    bool zone_node_local = false;                         // node of the first pinned CPU
+    std::size_t slice_slots = 0;                          // incremental sweep budget; 0 and 0 -> stop-the-world
+    double slice_us = 0;
+    std::vector<unsigned> survival;                       // empty -> 1, 10, 50 (gc_generational)
+    unsigned promote_after = 2;                           // checkpoints survived before Blue
+    sys::PageKind zone_pages = sys::PageKind::Normal;
+    bool prefault = false;                                // touch all of --zone-mb before the runs
+    std::string snapshot_path;                            // empty -> a temporary in the working directory
+    vgc::OffloadBound offload;                            // host link the bitfield_sweep bound assumes
+};
+
+// Accepts plain integers and k/M/G suffixes ("10k", "100M").
+static bool parse_size(const char* s, std::size_t& out) {
+    char* end = nullptr;
+    double v = std::strtod(s, &end);
+    if (end == s || v < 0) return false;
+    switch (*end) {
+        case '\0':          break;
+        case 'k': case 'K': v *= 1e3; ++end; break;
+        case 'm': case 'M': v *= 1e6; ++end; break;
+        case 'g': case 'G': v *= 1e9; ++end; break;
+        default: return false;
+    }
+    if (*end != '\0') return false;
+    out = static_cast<std::size_t>(v + 0.5);
+    return true;
+}
+
+// "4", "1,2,4", "all" (every core), or "sweep" (1..all).
+static bool parse_threads(const char* spec, std::vector<unsigned>& out) {
+    unsigned all = sys::cpu_count();
+    if (!std::strcmp(spec, "all")) {
+        out.push_back(all);
+        return true;
+    }
+    if (!std::strcmp(spec, "sweep")) {
+        for (unsigned t = 1; t <= all; ++t) out.push_back(t);
+        return true;
+    }
+    const char* s = spec;
+    for (;;) {
+        char* end = nullptr;
+        long t = std::strtol(s, &end, 10);
+        if (end == s || t <= 0 || t > 4096) return false;
+        out.push_back(static_cast<unsigned>(t));
+        if (*end == '\0') return true;
+        if (*end != ',') return false;
+        s = end + 1;
+    }
+}
+
+// Comma-separated sizes with k/M suffixes, each in [1, INT_MAX].
+static bool parse_chunks(const char* spec, std::vector<int>& out) {
+    std::string s(spec);
+    std::size_t pos = 0;
+    for (;;) {
+        std::size_t comma = s.find(',', pos);
+        std::size_t c = 0;
+        if (!parse_size(s.substr(pos, comma - pos).c_str(), c) || c == 0 || c > 0x7fffffff) return false;
+        out.push_back(static_cast<int>(c));
+        if (comma == std::string::npos) return true;
+        pos = comma + 1;
+    }
+}
+
+// Comma-separated percentages, 0..100.
+static bool parse_percents(const char* spec, std::vector<unsigned>& out) {
+    std::string s(spec);
+    std::size_t pos = 0;
+    for (;;) {
+        std::size_t comma = s.find(',', pos);
+        std::string item = s.substr(pos, comma - pos);
+        char* end = nullptr;
+        unsigned long v = std::strtoul(item.c_str(), &end, 10);
+        if (item.empty() || *end != '\0' || v > 100) return false;
+        out.push_back(static_cast<unsigned>(v));
+        if (comma == std::string::npos) return true;
+        pos = comma + 1;
+    }
+}
+
+// "10%", as a variant name that outlives the run.
+static const char* percent_name(unsigned pct) {
+    static const std::vector<std::string> names = [] {
+        std::vector<std::string> v;
+        for (unsigned k = 0; k <= 100; ++k) v.push_back(std::to_string(k) + "%");
+        return v;
+    }();
+    return names[pct > 100 ? 100 : pct].c_str();
+}
+
+// lo:hi[:factor], geometric. hi is always included.
+static bool parse_sweep(const std::string& spec, std::vector<std::size_t>& out) {
+    std::vector<std::string> parts;
+    std::size_t pos = 0;
+    for (;;) {
+        std::size_t colon = spec.find(':', pos);
+        parts.push_back(spec.substr(pos, colon - pos));
+        if (colon == std::string::npos) break;
+        pos = colon + 1;
+    }
+    if (parts.size() < 2 || parts.size() > 3) return false;
+
+    std::size_t lo = 0, hi = 0;
+    if (!parse_size(parts[0].c_str(), lo) || !parse_size(parts[1].c_str(), hi)) return false;
+    double factor = 2.0;
+    if (parts.size() == 3) {
+        char* end = nullptr;
+        factor = std::strtod(parts[2].c_str(), &end);
+        if (*end != '\0') return false;
+    }
+    if (lo == 0 || hi < lo || factor <= 1.0) return false;
+
+    for (double n = static_cast<double>(lo); n < static_cast<double>(hi) * (1.0 - 1e-9); n *= factor)
+        out.push_back(static_cast<std::size_t>(n + 0.5));
+    out.push_back(hi);
+    return true;
+}
+
+// One line per CPU in the order the placement policies start from.
+static void print_topology(const sys::Topology& t) {
+    std::cout << "Topology: " << t.packages << " packages, " << t.nodes << " NUMA nodes, " << t.l3_domains
+              << " L3 domains, " << t.cores << " cores, " << t.cpus.size() << " CPUs (" << t.threads_per_core()
+              << " per core)\n";
+    std::cout << std::right << std::setw(6) << "CPU" << std::setw(9) << "Package" << std::setw(6) << "Node"
+              << std::setw(8) << "L3" << std::setw(7) << "Core" << std::setw(5) << "SMT" << "\n";
+    for (const sys::Topology::Cpu& c : t.cpus)
+        std::cout << std::setw(6) << c.cpu << std::setw(9) << c.package << std::setw(6) << c.node << std::setw(8)
+                  << c.l3 << std::setw(7) << c.core << std::setw(5) << c.smt << "\n";
+    for (const sys::PinPolicyName& p : sys::kPinPolicies) {
+        std::cout << std::left << std::setw(9) << p.name << std::right << ":";
+        for (unsigned cpu : sys::placement(t, p.policy, static_cast<unsigned>(t.cpus.size()))) std::cout << " " << cpu;
+        std::cout << "\n";
+    }
+}
+
+static void usage(const char* argv0) {
+    std::cerr << "usage: " << argv0
+              << " [--list] [--workload NAME|all] [--n N | --sweep LO:HI[:FACTOR]] [--chunk C[,C..]]\n"
+              << "       [--warmup W] [--samples S] [--sample-ms MS] [--no-counters]\n"
+              << "       [--mem-sample-ms MS] [--threads T|T1,T2,..|all|sweep] [--kernel NAME|auto|all]\n"
+              << "       [--lambda NAME|all]\n"
+              << "       [--zone-mb MB] [--gate and|or|not|xor|xnor|nor|nand|and_not]\n"
+              << "       [--sweep-kernel NAME|auto|all] [--heap NAME|all] [--json FILE] [--csv FILE]\n"
+              << "       [--baseline save|check] [--baseline-dir DIR] [--threshold PCT] [--alpha A]\n"
+              << "       [--topology] [--pin compact|scatter|physical] [--zone-node local|none|N]\n"
+              << "       [--zone-pages normal|thp|2m|1g] [--prefault] [--slice-slots N] [--slice-us US]\n"
+              << "       [--survival PCT[,PCT..]] [--promote-after N] [--snapshot FILE]\n"
+              << "       [--link-gbps GB/S] [--offload-us US]\n";
+}
+
+static bool parse_args(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!std::strcmp(a, "--list")) {
+            std::size_t width = 0;
+            for (const Workload& w : kWorkloads) width = std::max(width, std::strlen(w.name));
+            for (const Workload& w : kWorkloads)
+                std::cout << std::left << std::setw(static_cast<int>(width + 2)) << w.name << w.title << "\n";
+            std::size_t count = 0;
+            const simd::LoopKernel* table = simd::loop_kernels(count);
+            std::cout << "\nLoop kernels (* = supported, auto = " << simd::select_loop_kernel().name << "):";
+            for (std::size_t k = 0; k < count; ++k)
+                std::cout << " " << table[k].name << (table[k].supported() ? "*" : "");
+            const engine::KernelEntry* lambdas = engine::kernels(count);
+            std::cout << "\nEngine kernels:";
+            for (std::size_t k = 0; k < count; ++k)
+                std::cout << " " << lambdas[k].name << " (" << lambdas[k].term << ")";
+            std::cout << "\nSweep kernels (auto = " << vgc::select_sweep_kernel().name << "):";
+            const vgc::SweepKernel* sweeps = vgc::sweep_kernels(count);
+            for (std::size_t k = 0; k < count; ++k)
+                std::cout << " " << sweeps[k].name << (sweeps[k].supported() ? "*" : "");
+            std::cout << "\nHeaps:";
+            for (const baseline::HeapName& h : baseline::kHeaps) std::cout << " " << h.name;
+            std::cout << "\n";
+            std::exit(0);
+        } else if (!std::strcmp(a, "--topology")) {
+            print_topology(sys::topology());
+            std::exit(0);
+        } else if (!std::strcmp(a, "--workload") && v) {
+            ++i;
+            if (!std::strcmp(v, "all")) {
+                opt.workloads.clear();
+                continue;
+            }
+            const Workload* w = find_workload(v);
+            if (!w) {
+                std::cerr << "unknown workload: " << v << "\n";
+                return false;
+            }
+            opt.workloads.push_back(w);
+        } else if (!std::strcmp(a, "--n") && v) {
+            ++i;
+            std::size_t n = 0;
+            if (!parse_size(v, n) || n == 0) {
+                std::cerr << "bad --n: " << v << "\n";
+                return false;
+            }
+            opt.sizes.push_back(n);
+        } else if (!std::strcmp(a, "--sweep") && v) {
+            ++i;
+            if (!parse_sweep(v, opt.sizes)) {
+                std::cerr << "bad --sweep: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--chunk") && v) {
+            ++i;
+            if (!parse_chunks(v, opt.chunk_sizes)) {
+                std::cerr << "bad --chunk: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--warmup") && v) {
+            ++i;
+            opt.measure.warmup = std::atoi(v);
+            if (opt.measure.warmup < 0) {
+                std::cerr << "bad --warmup: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--samples") && v) {
+            ++i;
+            opt.measure.samples = std::atoi(v);
+            if (opt.measure.samples <= 0) {
+                std::cerr << "bad --samples: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--sample-ms") && v) {
+            ++i;
+            opt.measure.sample_ms = std::atof(v);
+            if (opt.measure.sample_ms < 0) {
+                std::cerr << "bad --sample-ms: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--mem-sample-ms") && v) {
+            ++i;
+            opt.mem_sample_ms = std::atof(v);
+            if (opt.mem_sample_ms <= 0) {
+                std::cerr << "bad --mem-sample-ms: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--threads") && v) {
+            ++i;
+            if (!parse_threads(v, opt.threads)) {
+                std::cerr << "bad --threads: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--kernel") && v) {
+            ++i;
+            std::size_t count = 0;
+            const simd::LoopKernel* table = simd::loop_kernels(count);
+            if (!std::strcmp(v, "auto")) {
+                opt.kernels.push_back(&simd::select_loop_kernel());
+            } else if (!std::strcmp(v, "all")) {
+                for (std::size_t k = 0; k < count; ++k)
+                    if (table[k].supported()) opt.kernels.push_back(&table[k]);
+            } else {
+                const simd::LoopKernel* k = simd::find_loop_kernel(v);
+                if (!k || !k->supported()) {
+                    std::cerr << "kernel not available on this CPU: " << v << "\n";
+                    return false;
+                }
+                opt.kernels.push_back(k);
+            }
+        } else if (!std::strcmp(a, "--lambda") && v) {
+            ++i;
+            std::size_t count = 0;
+            const engine::KernelEntry* table = engine::kernels(count);
+            if (!std::strcmp(v, "all")) {
+                for (std::size_t k = 0; k < count; ++k) opt.lambdas.push_back(&table[k]);
+            } else {
+                const engine::KernelEntry* k = engine::find_kernel(v);
+                if (!k) {
+                    std::cerr << "unknown engine kernel: " << v << "\n";
+                    return false;
+                }
+                opt.lambdas.push_back(k);
+            }
+        } else if (!std::strcmp(a, "--zone-mb") && v) {
+            ++i;
+            std::size_t mb = 0;
+            if (!parse_size(v, mb) || mb == 0) {
+                std::cerr << "bad --zone-mb: " << v << "\n";
+                return false;
+            }
+            opt.zone_mb = mb;
+        } else if (!std::strcmp(a, "--gate") && v) {
+            ++i;
+            if (!vgc::find_gate(v, opt.gate)) {
+                std::cerr << "bad --gate: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--sweep-kernel") && v) {
+            ++i;
+            std::size_t count = 0;
+            const vgc::SweepKernel* table = vgc::sweep_kernels(count);
+            bool found = false;
+            for (std::size_t k = 0; k < count; ++k) {
+                bool pick = !std::strcmp(v, "all") ? table[k].supported() : !std::strcmp(v, table[k].name);
+                if (!pick) continue;
+                if (!table[k].supported()) break;
+                opt.sweep_kernels.push_back(&table[k]);
+                found = true;
+            }
+            if (!std::strcmp(v, "auto")) {
+                opt.sweep_kernels.push_back(&vgc::select_sweep_kernel());
+                found = true;
+            }
+            if (!found) {
+                std::cerr << "sweep kernel not available on this CPU: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--heap") && v) {
+            ++i;
+            baseline::Heap h;
+            if (!std::strcmp(v, "all")) {
+                for (const baseline::HeapName& n : baseline::kHeaps) opt.managers.push_back(n.heap);
+            } else if (baseline::find_heap(v, h)) {
+                opt.managers.push_back(h);
+            } else {
+                std::cerr << "unknown heap: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--json") && v) {
+            ++i;
+            opt.json_path = v;
+        } else if (!std::strcmp(a, "--csv") && v) {
+            ++i;
+            opt.csv_path = v;
+        } else if (!std::strcmp(a, "--baseline") && v) {
+            ++i;
+            if (!std::strcmp(v, "save")) {
+                opt.baseline = report::BaselineMode::Save;
+            } else if (!std::strcmp(v, "check")) {
+                opt.baseline = report::BaselineMode::Check;
+            } else {
+                std::cerr << "bad --baseline: " << v << " (save or check)\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--baseline-dir") && v) {
+            ++i;
+            opt.baseline_dir = v;
+        } else if (!std::strcmp(a, "--threshold") && v) {
+            ++i;
+            opt.threshold_pct = std::atof(v);
+            if (opt.threshold_pct < 0) {
+                std::cerr << "bad --threshold: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--alpha") && v) {
+            ++i;
+            opt.alpha = std::atof(v);
+            if (opt.alpha <= 0 || opt.alpha >= 1) {
+                std::cerr << "bad --alpha: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--pin") && v) {
+            ++i;
+            if (!sys::find_pin_policy(v, opt.pin)) {
+                std::cerr << "bad --pin: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--zone-node") && v) {
+            ++i;
+            char* end = nullptr;
+            long node = std::strtol(v, &end, 10);
+            opt.zone_node_local = !std::strcmp(v, "local");
+            if (!std::strcmp(v, "none") || opt.zone_node_local) {
+                opt.zone_node = -1;
+            } else if (end != v && *end == '\0' && node >= 0) {
+                opt.zone_node = static_cast<int>(node);
+            } else {
+                std::cerr << "bad --zone-node: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--zone-pages") && v) {
+            ++i;
+            bool found = false;
+            for (sys::PageKind k : {sys::PageKind::Normal, sys::PageKind::Transparent, sys::PageKind::Huge2M,
+                                    sys::PageKind::Huge1G})
+                if (!std::strcmp(v, sys::page_kind_name(k))) {
+                    opt.zone_pages = k;
+                    found = true;
+                }
+            if (!found) {
+                std::cerr << "bad --zone-pages: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--slice-slots") && v) {
+            ++i;
+            if (!parse_size(v, opt.slice_slots)) {
+                std::cerr << "bad --slice-slots: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--slice-us") && v) {
+            ++i;
+            char* end = nullptr;
+            opt.slice_us = std::strtod(v, &end);
+            if (end == v || *end != '\0' || opt.slice_us < 0) {
+                std::cerr << "bad --slice-us: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--survival") && v) {
+            ++i;
+            if (!parse_percents(v, opt.survival)) {
+                std::cerr << "bad --survival: " << v << "\n";
+                return false;
+            }
+        } else if (!std::strcmp(a, "--promote-after") && v) {
+            ++i;
+            int k = std::atoi(v);
+            if (k < 1 || k > 255) {
+                std::cerr << "bad --promote-after: " << v << "\n";
+                return false;
+            }
+            opt.promote_after = static_cast<unsigned>(k);
+        } else if ((!std::strcmp(a, "--link-gbps") || !std::strcmp(a, "--offload-us")) && v) {
+            ++i;
+            char* end = nullptr;
+            double x = std::strtod(v, &end);
+            bool link = !std::strcmp(a, "--link-gbps");
+            if (*end != '\0' || x < 0 || (link && x == 0)) {
+                std::cerr << "bad " << a << ": " << v << "\n";
+                return false;
+            }
+            (link ? opt.offload.link_gbps : opt.offload.latency_us) = x;
+        } else if (!std::strcmp(a, "--snapshot") && v) {
+            ++i;
+            opt.snapshot_path = v;
+        } else if (!std::strcmp(a, "--prefault")) {
+            opt.prefault = true;
+        } else if (!std::strcmp(a, "--no-counters")) {
+            opt.measure.hw_counters = false;
+        } else {
+            usage(argv[0]);
+            return false;
+        }
+    }
+    if (opt.workloads.empty())
+        for (const Workload& w : kWorkloads) opt.workloads.push_back(&w);
+    return true;
+}
+
+// ============================================================
+// Runner
+// ============================================================
+// Where run records go besides the console; `host` opens every record.
+struct Output {
+    report::Writer writer;
+    report::Baselines baselines;
+    report::Record host;
+
+    bool active() const { return writer.active() || baselines.active(); }
+};
+
+struct RunResult {
+    std::size_t n;
+    unsigned threads;
+    int chunk;             // recursion depth per chunk (chunked workloads)
+    const char* variant;   // kernel name, or ""
+    sys::Stats stats;
+    short checksum;
+};
+
+// Per-call TSC ticks and hardware counters. TSC rate vs. core cycles shows
+// whether a change saved work or only moved clock frequency.
+static void print_cycles(const sys::Measurement& m) {
+    double calls = static_cast<double>(m.total_calls());
+    std::cout << std::setprecision(1);
+    std::cout << "TSC/call     : " << m.tick_stats.median << " (min " << m.tick_stats.min << ")\n";
+    if (m.total_ms > 0)
+        std::cout << "TSC rate     : " << std::setprecision(3)
+                  << static_cast<double>(m.total_ticks) / (m.total_ms * 1e6) << " GHz\n";
+
+    const sys::CounterReadings& c = m.counters;
+    if (!c.any()) {
+        std::cout << "HW counters  : unavailable\n";
+        std::cout << std::setprecision(6);
+        return;
+    }
+    if (m.counter_threads > 1) std::cout << "HW counters  : summed over " << m.counter_threads << " pool threads\n";
+    for (int k = 0; k < sys::kCounterCount; ++k) {
+        std::cout << std::left << std::setw(13) << sys::counter_name(k) << std::right << ": ";
+        if (c.valid[k])
+            std::cout << std::setprecision(1) << static_cast<double>(c.value[k]) / calls << " /call\n";
+        else
+            std::cout << "n/a\n";
+    }
+    if (c.valid[sys::kCycles] && c.valid[sys::kInstructions] && c.value[sys::kCycles] > 0) {
+        std::cout << "IPC          : " << std::setprecision(3)
+                  << static_cast<double>(c.value[sys::kInstructions]) / static_cast<double>(c.value[sys::kCycles])
+                  << "\n";
+        // Per thread: idle workers park, so this is a floor for the busy ones.
+        if (m.total_ms > 0)
+            std::cout << "Core clock   : "
+                      << static_cast<double>(c.value[sys::kCycles]) / (m.total_ms * 1e6 * m.counter_threads)
+                      << " GHz" << (m.counter_threads > 1 ? " (mean per thread)" : "") << "\n";
+    }
+    std::cout << std::setprecision(6);
+}
+
+// Anything here is the workload's own: the harness records samples into
+// storage reserved up front and prints only after measure() returns.
+static void print_timed_region(const sys::Measurement& m) {
+    double calls = m.total_calls() ? static_cast<double>(m.total_calls()) : 1.0;
+    std::cout << "Timed Region : " << std::setprecision(1) << static_cast<double>(m.timed_allocs) / calls
+              << " allocs/call, " << m.timed_io_bytes << " B console output\n" << std::setprecision(6);
+}
+
+// Average busy time per dispatch for each pool thread; the spread is the
+// partition imbalance.
+static void print_threads(const sys::WorkerPool& pool, sys::PinPolicy pin) {
+    if (pool.dispatches() == 0) return;
+    std::cout << "Pinning      : " << sys::pin_policy_name(pin) << "\n";
+    double calls = static_cast<double>(pool.dispatches());
+    double lo = 0, hi = 0;
+    for (unsigned i = 0; i < pool.size(); ++i) {
+        double ms = pool.busy_ms(i) / calls;
+        unsigned cpu = pool.cpu_of(i);
+        std::cout << "Thread " << std::setw(3) << i << " (cpu " << std::setw(3) << cpu << ", node "
+                  << sys::topology().node_of(cpu) << "): " << std::setprecision(6) << ms << " ms\n";
+        if (i == 0 || ms < lo) lo = ms;
+        if (i == 0 || ms > hi) hi = ms;
+    }
+    if (pool.size() > 1 && hi > 0)
+        std::cout << "Imbalance    : " << std::setprecision(2) << 100.0 * (hi - lo) / hi << "%\n"
+                  << std::setprecision(6);
+}
+
+static void print_scheduler(const sys::ChunkScheduler& sched, const Params& p) {
+    std::uint64_t attempts = 0, steals = 0, stolen = 0;
+    for (unsigned i = 0; i < sched.stats().size(); ++i) {
+        const sys::ChunkScheduler::ThreadStats& s = sched.stats()[i];
+        attempts += s.steal_attempts;
+        steals += s.steals;
+        stolen += s.stolen;
+    }
+    double calls = p.pool && p.pool->dispatches() ? static_cast<double>(p.pool->dispatches()) : 1.0;
+    std::size_t step = p.lambda ? engine::kGrain : static_cast<std::size_t>(p.chunk_size);
+    std::cout << "Chunks       : " << (p.n + step - 1) / step << " x " << step << " steps\n";
+    std::cout << std::setprecision(1);
+    std::cout << "Steals/run   : " << static_cast<double>(steals) / calls << " batches, "
+              << static_cast<double>(stolen) / calls << " chunks (" << static_cast<double>(attempts) / calls
+              << " probes)\n";
+    std::cout << "Chunks/thread:";
+    for (unsigned i = 0; i < sched.stats().size(); ++i)
+        std::cout << " " << static_cast<double>(sched.stats()[i].chunks) / calls;
+    std::cout << "\n" << std::setprecision(6);
+}
+
+// Checksums that disagreed with a closed form, a reference or a second
+// engine on the same input. main() exits 3 if there were any.
+static std::size_t checksum_mismatches = 0;
+
+static bool checksums_agree(short got, short expect) {
+    if (got != expect) ++checksum_mismatches;
+    return got == expect;
+}
+
+// Measures the workload's single-thread reference with the same config.
+// Overhead is CPU time spent beyond the reference (pool busy time summed over
+// threads, or wall time for single-threaded engines) per unit of work: per
+// chunk for chunked workloads, per step otherwise.
+static void print_overhead(const Workload& w, const Params& p, const sys::Measurement& m,
+                           const sys::MeasureConfig& cfg) {
+    sys::Measurement ref = sys::measure([&] { return w.serial_ref(p); }, cfg);
+    double cpu_ms = m.stats.median;
+    if (p.pool && p.pool->dispatches()) {
+        cpu_ms = 0;
+        for (unsigned i = 0; i < p.pool->size(); ++i) cpu_ms += p.pool->busy_ms(i);
+        cpu_ms /= static_cast<double>(p.pool->dispatches());
+    }
+    std::size_t step = static_cast<std::size_t>(p.chunk_size);
+    std::size_t units = (w.flags & kChunked) ? (p.n + step - 1) / step : p.n;
+    std::cout << "Serial Ref   : " << ref.stats.median << " ms (checksum " << ref.checksum
+              << (checksums_agree(ref.checksum, m.checksum) ? ", match" : ", MISMATCH") << ")\n";
+    std::cout << "Overhead     : " << std::setprecision(3)
+              << (cpu_ms - ref.stats.median) * 1e6 / static_cast<double>(units)
+              << ((w.flags & kChunked) ? " ns/chunk" : " ns/step") << " (" << std::setprecision(6) << cpu_ms
+              << " ms CPU)\n";
+    if (m.stats.median > 0)
+        std::cout << "Speedup      : " << std::setprecision(2) << ref.stats.median / m.stats.median
+                  << "x vs serial ref\n" << std::setprecision(6);
+}
+
+// Each zone workload resets its zone per call, so the zone counters after
+// the last call are per-call figures. Overhead is what the zone holds beyond
+// the peak of live requested bytes: size-class rounding plus free blocks.
+// Resident is what of the committed range has physical pages behind it,
+// which RSS mixes in with the rest of the process. ns/alloc is the whole
+// call spread over the allocations, so it is left out where the call does
+// far more than allocate (the coroutine frames, timed on their own).
+static void print_zones(const vgc::ZoneSet& zones, const sys::Measurement& m, bool per_alloc) {
+    const vgc::Zone& first = zones.red;
+    std::cout << "Zone Pages   : " << sys::page_kind_name(first.pages()) << ", "
+              << sys::page_size(first.pages()) / 1024 << " KB pages, commit step " << first.commit_step() / 1024
+              << " KB" << (first.precommitted() ? ", committed at reservation" : "") << "\n";
+    for (const vgc::Zone* z : {&zones.red, &zones.green, &zones.blue}) {
+        if (z->allocs() == 0) continue;
+        double allocs = static_cast<double>(z->allocs());
+        std::size_t overhead = z->used_bytes() - z->peak_live_bytes();
+        std::cout << std::left << std::setw(13) << (std::string("Zone ") + z->name()) << std::right << ": "
+                  << z->allocs() << " allocs, " << z->frees() << " frees per call\n";
+        if (per_alloc)
+            std::cout << "ns/alloc     : " << std::setprecision(3) << m.stats.median * 1e6 / allocs << "\n";
+        std::cout << "Zone Bytes   : used " << z->used_bytes() / 1024 << " KB, peak live "
+                  << z->peak_live_bytes() / 1024 << " KB, committed " << z->committed_bytes() / 1024 << " KB of "
+                  << z->capacity_bytes() / (1024 * 1024) << " MB, resident " << z->resident_bytes() / 1024
+                  << " KB\n";
+        std::cout << "Overhead     : " << overhead << " B (" << std::setprecision(1)
+                  << (z->peak_live_bytes() ? 100.0 * static_cast<double>(overhead) /
+                                                 static_cast<double>(z->peak_live_bytes())
+                                           : 0.0)
+                  << "% of peak live, " << std::setprecision(2) << static_cast<double>(overhead) / allocs
+                  << " B/alloc)\n" << std::setprecision(6);
+    }
+}
+
+// Bytes per slot is the liveness metadata a sweep has to stream through.
+// Offloading this sweep can be no faster than the bound (offload.hpp); the
+// crossover is the heap size above which the bound beats the CPU sweep,
+// assuming the CPU's time per slot holds at that size. The device returns
+// `out` and the host still visits its bits, so the bound is set against
+// the CPU's gate pass alone, timed here with the same config.
+static void print_offload(const Params& p, const sys::MeasureConfig& cfg) {
+    const vgc::OffloadBound& b = p.offload;
+    std::size_t n = p.n;
+    sys::Measurement gate =
+        sys::measure([&] { return vgc::bitfield_gate_only(*p.heap, n, p.gate, *p.sweep_kernel); }, cfg);
+    double cpu_ms = gate.stats.median;
+    double cpu_ns = n ? cpu_ms * 1e6 / static_cast<double>(n) : 0;
+    std::cout << "Offload Bound: " << std::setprecision(3) << b.ms(n) << " ms over a " << b.link_gbps << " GB/s link + "
+              << b.latency_us << " us, vs " << cpu_ms << " ms gate pass here (" << cpu_ns << " vs "
+              << b.link_ns_per_slot() << " ns/slot, host visit excluded on both sides)\n";
+    double x = b.crossover(cpu_ns);
+    if (x > 0)
+        std::cout << "Crossover    : offload could pay above " << std::setprecision(0) << x << " slots ("
+                  << x * 3 / 8 / 1024 << " KB of bitfields)\n";
+    else
+        std::cout << "Crossover    : none, the CPU gates a slot faster than the link carries its bitfields\n";
+    std::cout << std::setprecision(6);
+}
+
+static void print_sweep(const Params& p, const sys::MeasureConfig& cfg) {
+    const vgc::Bitfield& out = p.heap->out();
+    if (p.sweep_kernel) {
+        std::cout << "Sweep Kernel : " << p.sweep_kernel->name << ", gate " << vgc::gate_name(p.gate) << " ("
+                  << out.count() << " of " << p.n << " slots selected)\n";
+        std::cout << "Liveness Data: " << p.heap->bitfield_bytes() / 1024 << " KB (3 bitfields, "
+                  << std::setprecision(3) << 3.0 / 8 << " B/slot)\n";
+        print_offload(p, cfg);
+    } else {
+        std::cout << "Sweep Gate   : " << vgc::gate_name(p.gate) << "\n";
+    }
+    if (p.heap->header_bytes())
+        std::cout << "Header Heap  : " << p.heap->header_bytes() / 1024 << " KB ("
+                  << sizeof(vgc::SweepHeap::ObjectHeader) << " B/slot)\n";
+    std::cout << std::setprecision(6);
+}
+
+static void print_yield(const vgc::YieldCache& y, const Workload& w) {
+    if (w.run != run_yield_loop_temp) {
+        std::cout << "Zone Path    : " << y.zone().name() << " zone, spinlock per alloc and free\n";
+        return;
+    }
+    const vgc::YieldCache::Stats& s = y.stats();
+    std::cout << "Yield Cache  : " << s.allocs << " allocs, " << s.refills << " refills, " << s.flushes
+              << " flushes per call (" << vgc::YieldCache::kBatch << " blocks per batch)\n";
+    std::cout << "Cached Blocks: " << y.cached_blocks() << " (" << y.zone().name() << " zone)\n";
+}
+
+// Pauses run from the first barrier (every mutator stopped) to the end of
+// the sweep; mutator throughput is objects per second of wall time.
+static void print_collector(const vgc::ParallelCollector& gc, const Params& p, const sys::Measurement& m) {
+    std::uint64_t marked = 0, swept = 0;
+    for (unsigned i = 0; i < gc.stats().size(); ++i) {
+        marked += gc.stats()[i].marked;
+        swept += gc.stats()[i].swept;
+    }
+    double calls = p.pool && p.pool->dispatches() ? static_cast<double>(p.pool->dispatches()) : 1.0;
+    double pause_total = 0;
+    for (double ms : gc.pauses()) pause_total += ms;
+    sys::Stats ps = sys::summarize(gc.pauses());
+    std::cout << "Collections  : " << gc.pauses().size() << " per call (every "
+              << vgc::ParallelCollector::kPeriod << " allocs/thread, " << vgc::ParallelCollector::kRoots
+              << " roots/thread)\n";
+    std::cout << std::setprecision(1) << "Marked/Swept : " << static_cast<double>(marked) / calls << " / "
+              << static_cast<double>(swept) / calls << " objects per call\n";
+    std::cout << std::setprecision(3) << "Pause (ms)   : median " << ps.median << ", p99 " << ps.p99 << ", p99.9 "
+              << ps.p999 << ", max " << ps.max << " (" << pause_total << " ms total)\n";
+    if (m.stats.median > 0)
+        std::cout << "Mutator Rate : " << static_cast<double>(p.n) / (m.stats.median * 1e3) << " M objects/s ("
+                  << std::setprecision(1) << 100.0 * (1.0 - pause_total / m.stats.median) << "% outside pauses)\n";
+    std::cout << std::setprecision(6);
+}
+
+// Per-collection figures; a layered heap is also measured against a
+// single-layer one with the same constants, runtime objects and slicing.
+// Pauses are the mark pauses plus, when incremental, every sweep slice.
+static void print_layers(const vgc::LayeredHeap& h, const Params& p, const sys::Measurement& m,
+                         const sys::MeasureConfig& cfg) {
+    const vgc::LayeredHeap::Stats& s = h.stats();
+    double cycles = s.collections ? static_cast<double>(s.collections) : 1.0;
+    const vgc::Zone& home = h.layered() ? h.passive() : h.active();
+    std::cout << "Constants    : " << h.constants() << " objects, " << h.constant_bytes() / 1024 << " KB in the "
+              << home.name() << " zone" << (home.frozen() ? " (frozen, read-only)" : " (collected)") << "\n";
+    std::cout << "Collection   : ";
+    if (!h.incremental()) std::cout << "stop-the-world\n";
+    else
+        std::cout << "incremental, sweep slices of " << (h.slice_slots() ? std::to_string(h.slice_slots()) : "any")
+                  << " slots / " << (h.slice_us() > 0 ? std::to_string(static_cast<long>(h.slice_us())) : "any")
+                  << " us every " << vgc::LayeredHeap::kSliceEvery << " allocs\n";
+    std::cout << std::setprecision(1) << "Per Cycle    : " << static_cast<double>(s.marked) / cycles << " marked, "
+              << static_cast<double>(s.swept) / cycles << " swept, " << static_cast<double>(s.slices) / cycles
+              << " slices (" << h.pauses().size() << " pauses per call)\n";
+    sys::Stats ps = sys::summarize(h.pauses());
+    double pause_total = 0;
+    for (double ms : h.pauses()) pause_total += ms;
+    std::cout << std::setprecision(3) << "Pause (ms)   : median " << ps.median << ", p99 " << ps.p99 << ", p99.9 "
+              << ps.p999 << ", max " << ps.max << " (" << pause_total << " ms total)\n";
+    if (h.layered()) {
+        vgc::LayeredHeap flat(false);
+        flat.set_slicing(h.slice_slots(), h.slice_us());
+        if (flat.ok()) {
+            Params q = p;
+            q.layers = &flat;
+            sys::Measurement fm = sys::measure([&] { return run_gc_layered(q); }, cfg);
+            sys::Stats fs = sys::summarize(flat.pauses());
+            double flat_total = 0;
+            for (double ms : flat.pauses()) flat_total += ms;
+            std::cout << "Single Layer : " << std::setprecision(6) << fm.stats.median << " ms (checksum "
+                      << fm.checksum << (checksums_agree(fm.checksum, m.checksum) ? ", match" : ", MISMATCH")
+                      << "), pause max " << std::setprecision(3) << fs.max << " (" << flat_total << " ms total)\n";
+            if (flat_total > 0 && fm.stats.median > 0)
+                std::cout << "Layer Savings: " << std::setprecision(1) << 100.0 * (1.0 - pause_total / flat_total)
+                          << "% of pause time, " << 100.0 * (1.0 - m.stats.median / fm.stats.median)
+                          << "% of run time\n";
+        }
+    }
+    std::cout << std::setprecision(6);
+}
+
+// The rebuilt zone pays its page faults again every call (it is trimmed
+// first); the mapping's come from the page cache. A mapped run also measures
+// the rebuild with the same config: the two are different startups, not a
+// parallel run and its serial form, so they are compared as a ratio only.
+static void print_snapshot(const vgc::ConstantSnapshot& s, const Workload& w, const Params& p,
+                           const sys::Measurement& m, const sys::MeasureConfig& cfg) {
+    bool mapped = w.run == run_snapshot_map;
+    std::cout << "Snapshot     : " << s.path() << ", image " << s.image_bytes() / 1024 << " KB + checkpoint "
+              << s.bitfield_bytes() / 1024 << " KB, "
+              << (mapped ? "mapped read-only, no fixup" : "rebuilt on fresh pages and frozen") << "\n";
+    if (!mapped) return;
+    sys::Measurement rebuild = sys::measure([&] { return run_snapshot_rebuild(p); }, cfg);
+    std::cout << "Rebuild      : " << rebuild.stats.median << " ms (checksum " << rebuild.checksum
+              << (checksums_agree(rebuild.checksum, m.checksum) ? ", match" : ", MISMATCH") << ")\n";
+    if (m.stats.median > 0)
+        std::cout << "Map vs Build : " << std::setprecision(2) << rebuild.stats.median / m.stats.median
+                  << "x faster to map than to rebuild\n" << std::setprecision(6);
+}
+
+// Per-call figures of the last call; survival is measured, not the target.
+static void print_generations(const vgc::GenerationalHeap& h, const Params& p, const sys::Measurement& m) {
+    using Heap = vgc::GenerationalHeap;
+    const Heap::Stats& s = h.stats();
+    double young = s.allocated ? static_cast<double>(s.allocated) : 1.0;
+    std::cout << "Policy       : promote after " << h.promote_after() << " checkpoints, major every "
+              << Heap::kMajorEvery << " minors, batches of " << Heap::kBatch << " every " << Heap::kDrainEvery
+              << " allocs\n";
+    std::cout << std::setprecision(2) << "Survival     : " << 100.0 * static_cast<double>(s.evacuated) / young
+              << "% of the nursery (target " << p.survival_pct << "%), "
+              << 100.0 * static_cast<double>(s.promoted) / young << "% promoted\n";
+    std::cout << "Per Call     : " << s.minors << " minor + " << s.majors << " major collections, " << s.evacuated
+              << " copied to " << (h.promote_after() > 1 ? h.green().name() : h.blue().name()) << " ("
+              << s.evacuated_bytes / 1024 << " KB), " << s.promoted << " promoted (" << s.promoted_bytes / 1024
+              << " KB) in " << s.batches << " batches\n";
+    std::cout << "Swept        : " << s.swept_green << " " << h.green().name() << ", " << s.swept_blue << " "
+              << h.blue().name() << "\n";
+    std::cout << "Forwarding   : " << s.lazy_reads << " roots fixed by the mutator, " << s.fixups
+              << " by the next collection\n";
+    sys::Stats mi = sys::summarize(h.minor_pauses()), ma = sys::summarize(h.major_pauses());
+    std::cout << std::setprecision(3) << "Minor Pause  : median " << mi.median << ", p99 " << mi.p99 << ", max "
+              << mi.max << " ms\n";
+    if (!h.major_pauses().empty())
+        std::cout << "Major Pause  : median " << ma.median << ", max " << ma.max << " ms\n";
+    if (s.promoted && m.stats.median > 0)
+        std::cout << "Promotion    : " << s.promote_ms << " ms per call in batches ("
+                  << std::setprecision(1) << 100.0 * s.promote_ms / m.stats.median << "% of run time), "
+                  << std::setprecision(1) << s.promote_ms * 1e6 / static_cast<double>(s.promoted)
+                  << " ns per object\n";
+    std::cout << std::setprecision(6);
+}
+
+// Mean phase times per call, all contexts running against context 0
+// running alone. A slowdown is interference from the other contexts: each
+// has its own zones and cache, so only the machine is shared.
+static void print_interpreters(vgc::InterpreterSet& set, const Params& p, const sys::Measurement& m,
+                               const sys::MeasureConfig& cfg) {
+    using Set = vgc::InterpreterSet;
+    const unsigned k = set.size();
+    auto mean_ms = [](const Set::Context& c, unsigned ph) {
+        return c.calls ? c.phase_ms[ph] / static_cast<double>(c.calls) : 0.0;
+    };
+    std::vector<Set::Context> together;
+    for (unsigned i = 0; i < k; ++i) together.push_back(set.contexts()[i]);
+    set.reset_stats();
+    sys::Measurement solo = sys::measure([&] { return set.run_solo(p.n, p.chunk_size); }, cfg);
+    const Set::Context& alone = set.contexts()[0];
+
+    std::cout << "Contexts     : " << k << ", each with its own 3 x "
+              << set.zones(0).red.capacity_bytes() / (1024 * 1024) << " MB zone set and Yield Memory cache\n";
+    std::cout << std::setprecision(3) << "Solo Context : " << solo.stats.median << " ms per script\n";
+    std::cout << std::left << std::setw(13) << "Phase (ms)" << std::right << std::setw(10) << "solo"
+              << std::setw(10) << "median" << std::setw(10) << "max" << std::setw(11) << "slowdown" << "\n";
+    double solo_script = 0, worst_script = 0;
+    std::vector<double> scripts(k, 0.0);
+    for (unsigned ph = 0; ph < Set::kPhaseCount; ++ph) {
+        std::vector<double> xs;
+        for (unsigned i = 0; i < k; ++i) {
+            xs.push_back(mean_ms(together[i], ph));
+            scripts[i] += xs.back();
+        }
+        sys::Stats st = sys::summarize(xs);
+        double one = mean_ms(alone, ph);
+        solo_script += one;
+        std::cout << std::left << std::setw(13) << Set::phase_name(ph) << std::right << std::setw(10) << one
+                  << std::setw(10) << st.median << std::setw(10) << st.max;
+        if (one > 0)
+            std::cout << std::setw(10) << std::setprecision(1) << 100.0 * (st.median / one - 1.0) << "%"
+                      << std::setprecision(3);
+        std::cout << "\n";
+    }
+    for (double s : scripts) worst_script = s > worst_script ? s : worst_script;
+    double steps = 4.0 * static_cast<double>(p.n) * k;
+    if (m.stats.median > 0 && solo.stats.median > 0) {
+        double rate = steps / (m.stats.median * 1e3);
+        double solo_rate = 4.0 * static_cast<double>(p.n) / (solo.stats.median * 1e3);
+        std::cout << "Throughput   : " << std::setprecision(1) << rate << " M steps/s aggregate, "
+                  << rate / solo_rate << "x one context (" << 100.0 * rate / (solo_rate * k) << "% of " << k
+                  << "x)\n";
+    }
+    if (solo_script > 0)
+        std::cout << "Interference : slowest context " << std::setprecision(1)
+                  << 100.0 * (worst_script / solo_script - 1.0) << "% over solo\n";
+    std::cout << std::setprecision(6);
+}
+
+// Untimed, after the measurement: whether this build's recursion pushes a
+// frame per level (stack_probe.hpp), and the logical calls it makes. A
+// chunk of depth d is d + 1 recursive_chunk calls, the last one returning.
+static void print_stack_profile(const Workload& w, const Params& p, const sys::Measurement& m) {
+    deep::StackProfile s = deep::profile_stack(
+        [&](int depth) {
+            Params one = p;
+            one.n = static_cast<std::size_t>(depth);
+            one.chunk_size = depth;
+            return w.run(one);
+        },
+        p.chunk_size);
+    if (!s.ok) {
+        std::cout << "Stack Probe  : " << (s.overflow ? "past the " : "unavailable, no thread with the ")
+                  << deep::kPaintBytes / (1024 * 1024) << " MB paint\n";
+    } else {
+        std::cout << "Stack Probe  : " << std::setprecision(0) << s.peak_bytes() << " B peak at depth " << s.depth
+                  << " (" << std::setprecision(1) << s.bytes_per_level << " B/level";
+        if (s.measured_depth < s.depth) std::cout << ", extrapolated from depth " << s.measured_depth;
+        std::cout << ") -> " << (s.recursing() ? "native recursion" : "constant stack, no frame per level")
+                  << "\n";
+    }
+    std::size_t step = static_cast<std::size_t>(p.chunk_size);
+    std::size_t chunks = (p.n + step - 1) / step;
+    double calls = static_cast<double>(chunks) * static_cast<double>(step + 1);
+    std::cout << "Calls        : " << chunks << " chunks x " << step + 1 << " levels = " << std::setprecision(0)
+              << calls << " per run, " << std::setprecision(3) << m.stats.median * 1e6 / calls << " ns/level ("
+              << report::compiler() << ", " << report::build_flags() << ")\n";
+    std::cout << std::setprecision(6);
+}
+
+#if defined(VGC_HAS_COROUTINES)
+// Per call, from the last one. Frame cost is the time over the native
+// call stack (Overhead, above) spread over the frames. Frame Alloc times
+// the frame source alone, replaying the call's alloc/free pattern.
+template <class Frames>
+static void print_coroutines(deep::CoroutineDriver<Frames>& d, const sys::Measurement& m,
+                             const sys::MeasureConfig& cfg) {
+    const deep::FrameStats& s = d.stats();
+    std::cout << "Frames       : " << s.frames << " per call, " << s.frame_bytes << " B each, from the "
+              << d.source() << ", " << deep::CoroutineDriver<Frames>::kInFlight << " in flight\n";
+    if (s.frames && m.stats.median > 0)
+        std::cout << "Resumes      : " << s.resumes << " per call (" << std::setprecision(1)
+                  << static_cast<double>(s.resumes) / static_cast<double>(s.frames) << " per frame, every "
+                  << deep::kYieldEvery << " levels), " << m.stats.median * 1e6 / static_cast<double>(s.frames)
+                  << " ns per chunk\n" << std::setprecision(6);
+    std::uint64_t frames = s.frames;
+    if (!frames) return;
+    sys::Measurement fa = sys::measure([&] { return d.churn_frames(frames); }, cfg);
+    double ns = fa.stats.median * 1e6 / static_cast<double>(frames);
+    std::cout << "Frame Alloc  : " << std::setprecision(1) << ns << " ns per alloc + free from the " << d.source()
+              << " (" << (m.stats.median > 0 ? 100.0 * fa.stats.median / m.stats.median : 0.0) << "% of the call)\n"
+              << std::setprecision(6);
+}
+#endif
+
+static void print_memory(const sys::MemoryReport& r, const sys::MemorySampler* sampler) {
+    std::cout << "Memory Before: " << r.before.rss_kb << " KB\n";
+    std::cout << "Memory After : " << r.after.rss_kb << " KB\n";
+    std::cout << "Memory Delta : " << r.rss_delta_kb() << " KB\n";
+    std::cout << "Peak RSS     : " << r.after.peak_rss_kb << " KB"
+              << (r.peak_is_per_run ? "" : " (process lifetime)") << "\n";
+    std::cout << "Page Faults  : " << r.minor_faults() << " minor, " << r.major_faults() << " major\n";
+    if (sampler) {
+        const std::vector<sys::MemoryPoint>& tl = sampler->timeline();
+        std::cout << "RSS Timeline : " << tl.size() << " points";
+        if (!tl.empty())
+            std::cout << " over " << std::setprecision(3) << tl.back().t_ms << " ms, peak "
+                      << sampler->peak_kb() << " KB";
+        std::cout << "\n" << std::setprecision(6);
+    }
+}
+
+// Every field is present in every record (null when it does not apply), so
+// one CSV can hold any mix of workloads. Counters are totals over
+// `calls` (samples x iters) and null where the PMU had no such event.
+static report::Record run_record(const Workload& w, const Params& p, const Output& out,
+                                 const sys::MeasureConfig& cfg, const sys::Measurement& m,
+                                 const sys::MemoryReport& mem, unsigned threads, const char* variant,
+                                 const char* oracle) {
+    report::Record r = out.host;
+    r.str("workload", w.name).num("n", p.n);
+    if (w.flags & kChunked) r.num("chunk", p.chunk_size);
+    else r.null("chunk");
+    r.num("threads", threads).str("variant", variant);
+    if (w.flags & kSweep) r.str("gate", vgc::gate_name(p.gate));
+    else r.null("gate");
+    r.num("checksum", m.checksum);
+    if (*oracle) r.str("oracle", oracle);
+    else r.null("oracle");
+
+    const sys::Stats& st = m.stats;
+    r.num("warmup", cfg.warmup).num("iters", m.iters).num("calls", m.total_calls());
+    r.num("median_ms", st.median).num("min_ms", st.min).num("p90_ms", st.p90).num("p99_ms", st.p99)
+        .num("p999_ms", st.p999).num("max_ms", st.max).num("mean_ms", st.mean).num("stddev_ms", st.stddev);
+    r.array("sample_ms", m.sample_ms).array("sample_ticks", m.sample_ticks);
+    if (m.total_ms > 0) r.num("tsc_ghz", static_cast<double>(m.total_ticks) / (m.total_ms * 1e6));
+    else r.null("tsc_ghz");
+    for (int k = 0; k < sys::kCounterCount; ++k) {
+        std::string key = sys::counter_name(k);
+        for (char& c : key)
+            if (c == '-') c = '_';
+        if (m.counters.valid[k]) r.num(key.c_str(), m.counters.value[k]);
+        else r.null(key.c_str());
+    }
+    r.num("counter_threads", m.counter_threads);
+    r.num("rss_before_kb", mem.before.rss_kb).num("rss_after_kb", mem.after.rss_kb)
+        .num("peak_rss_kb", mem.after.peak_rss_kb).flag("peak_rss_per_run", mem.peak_is_per_run)
+        .num("minor_faults", mem.minor_faults()).num("major_faults", mem.major_faults());
+    r.num("timed_allocs", m.timed_allocs).num("timed_io_bytes", m.timed_io_bytes);
+    return r;
+}
+
+static void print_baseline(const report::Baselines& b, const std::vector<report::Verdict>& vs) {
+    if (vs.empty()) {
+        std::cout << "Baseline     : none for this configuration in " << b.dir() << "\n";
+        return;
+    }
+    for (const report::Verdict& v : vs) {
+        std::cout << std::left << std::setw(13) << (std::string("vs ") + v.metric) << std::right << ": ";
+        if (v.exact) {
+            std::cout << v.before_text << " -> " << v.after_text << (v.regressed ? " REGRESSION" : "") << "\n";
+            continue;
+        }
+        std::cout << std::showpos << std::setprecision(2) << v.change_pct << "%" << std::noshowpos << " ("
+                  << std::setprecision(*v.unit == 'm' ? 6 : 1) << v.before << " -> " << v.after << " " << v.unit;
+        if (v.p < 1) std::cout << ", p=" << std::setprecision(4) << v.p;
+        std::cout << ")" << (v.regressed ? " REGRESSION" : "") << "\n";
+    }
+    std::cout << std::setprecision(6);
+}
+
+static RunResult run_here(const Workload& w, const Params& p, const Options& opt, Output& out) {
+    sys::MeasureConfig cfg = opt.measure;
+    if (p.pool && cfg.hw_counters) cfg.thread_counters = p.pool->counters();
+    unsigned threads = p.pool ? p.pool->size() : 1;
+    std::cout << "=== VGC 2.5 " << w.title << " (" << (threads > 1 ? "Multi-Core" : "Single-Core")
+              << ", N=" << p.n << ", Short Checksum) ===\n";
+    std::cout << w.n_label << ": " << p.n << "\n";
+    if ((w.flags & kChunked) && threads > 1)
+        std::cout << "Recursion Depth per Chunk: " << p.chunk_size << ", Workers: " << threads << "\n\n";
+    else if ((w.flags & kChunked))
+        std::cout << "Recursion Depth per Chunk: " << p.chunk_size << "\n\n";
+    else if (threads > 1)
+        std::cout << "Partitions: " << threads << " (Multi-Core)\n\n";
+    else if (p.kernel)
+        std::cout << "Partitions: 1 (Single-Core), Kernel: " << p.kernel->name << "\n\n";
+    else if (p.lambda)
+        std::cout << "Partitions: 1 (Single-Core), Kernel: " << p.lambda->name
+                  << (w.run == run_lambda_simd ? std::string(", ") + engine::simd_isa() : std::string()) << "\n\n";
+    else
+        std::cout << "Partitions: 1 (Single-Core)\n\n";
+
+    sys::MemoryReport mem;
+    mem.peak_is_per_run = sys::reset_peak_rss();
+    mem.before = sys::memory_snapshot();
+
+    std::unique_ptr<sys::MemorySampler> sampler;
+    if (opt.mem_sample_ms > 0) {
+        sampler.reset(new sys::MemorySampler(opt.mem_sample_ms));
+        sampler->start();
+    }
+
+    if (p.pool) p.pool->reset_stats();
+    if (p.sched) p.sched->reset_stats();
+    if (p.collector) p.collector->reset_stats();
+    if (p.layers) p.layers->reset_stats();
+    if (p.interpreters) p.interpreters->reset_stats();
+    sys::Measurement m = sys::measure([&] { return w.run(p); }, cfg);
+    const sys::Stats& st = m.stats;
+
+    if (sampler) sampler->stop();
+    mem.after = sys::memory_snapshot();
+
+    std::cout << w.section << "\n";
+    std::cout << "Samples: " << m.sample_ms.size() << " x " << m.iters
+              << " iters (warmup " << cfg.warmup << ")\n";
+    std::cout << std::fixed << std::setprecision(6);
+    std::cout << "Time: " << st.median << " ms (median)\n";
+    std::cout << "Min/P90/P99  : " << st.min << " / " << st.p90 << " / " << st.p99 << " ms\n";
+    std::cout << "P99.9/Max    : " << st.p999 << " / " << st.max << " ms\n";
+    std::cout << "Stddev       : " << st.stddev << " ms ("
+              << std::setprecision(2) << (st.mean > 0 ? 100.0 * st.stddev / st.mean : 0.0)
+              << "% of mean)\n";
+    print_cycles(m);
+    print_timed_region(m);
+    if (p.pool) print_threads(*p.pool, opt.pin);
+    if (p.sched) print_scheduler(*p.sched, p);
+    if (w.serial_ref) print_overhead(w, p, m, cfg);
+    std::cout << "Checksum: " << m.checksum << "\n";
+    const char* oracle = "";
+    if (w.oracle) {
+        short expect = w.oracle(p);
+        bool agree = checksums_agree(m.checksum, expect);
+        oracle = agree ? "match" : "mismatch";
+        std::cout << "Oracle       : " << (agree ? "match" : "MISMATCH") << " (closed form "
+                  << expect << ")\n";
+    }
+    if (w.flags & kBigStack)
+        std::cout << "Native Stack : " << deep::native_stack_bytes(p.chunk_size) / (1024 * 1024) << " MB thread\n";
+    if (p.frames) std::cout << "Frame Stack  : " << p.frames->reserved_bytes() / 1024 << " KB (heap)\n";
+#if defined(VGC_HAS_COROUTINES)
+    bool frames_only = p.coro_zone != nullptr;
+#else
+    bool frames_only = false;
+#endif
+    if (p.zones && p.manager == baseline::Heap::Zone) print_zones(*p.zones, m, !frames_only);
+    if (p.heap) print_sweep(p, cfg);
+    if (p.yield) print_yield(*p.yield, w);
+    if (p.collector) print_collector(*p.collector, p, m);
+    if (p.layers) print_layers(*p.layers, p, m, cfg);
+    if (p.generations) print_generations(*p.generations, p, m);
+    if (p.snapshot) print_snapshot(*p.snapshot, w, p, m, cfg);
+    if (p.interpreters) print_interpreters(*p.interpreters, p, m, cfg);
+#if defined(VGC_HAS_COROUTINES)
+    if (p.coro_zone) print_coroutines(*p.coro_zone, m, cfg);
+    if (p.coro_heap) print_coroutines(*p.coro_heap, m, cfg);
+#endif
+    if (w.flags & kRecursive) print_stack_profile(w, p, m);
+    print_memory(mem, sampler.get());
+
+    int chunk = (w.flags & kChunked) ? p.chunk_size : 0;
+    const char* variant = p.kernel ? p.kernel->name
+                          : p.lambda ? p.lambda->name
+                          : p.sweep_kernel ? p.sweep_kernel->name
+                          : (w.flags & kHeap) ? baseline::heap_name(p.manager)
+                          : p.generations ? percent_name(p.survival_pct) : "";
+    if (out.active()) {
+        report::Record rec = run_record(w, p, out, cfg, m, mem, threads, variant, oracle);
+        out.writer.write(rec);
+        if (out.baselines.mode() == report::BaselineMode::Save && !out.baselines.save(rec))
+            std::cerr << "could not write baseline " << out.baselines.path_for(rec) << "\n";
+        if (out.baselines.mode() == report::BaselineMode::Check)
+            print_baseline(out.baselines, out.baselines.check(rec));
+    }
+    std::cout << "===============================================================\n\n";
+    return {p.n, threads, chunk, variant, st, m.checksum};
+}
+
+static RunResult run_one(const Workload& w, const Params& p, const Options& opt, Output& out) {
+    if (!(w.flags & kBigStack)) return run_here(w, p, opt, out);
+    // Native recursion at --chunk depth needs a stack to match; the
+    // trampoline and explicit-stack engines run there too so their serial
+    // reference (native recursive_driver) can reach the same depth.
+    RunResult r{};
+    std::size_t bytes = deep::native_stack_bytes(p.chunk_size);
+    auto body = [&] {
+        sys::pin_to_core_and_boost(0);
+        r = run_here(w, p, opt, out);
+    };
+    if (!sys::run_on_stack(bytes, body)) {
+        std::cerr << "could not create a " << bytes / (1024 * 1024) << " MB stack thread for " << w.name << "\n";
+        std::exit(1);
+    }
+    return r;
+}
+
+static void print_scaling(const Workload& w, const std::vector<RunResult>& rs) {
+    std::cout << "--- Scaling: " << w.name << " ---\n";
+    std::cout << std::right << std::setw(14) << "N" << std::setw(10) << "Depth" << std::setw(11) << "Variant"
+              << std::setw(16) << "Median (ms)" << std::setw(16) << "P99 (ms)" << std::setw(14) << "ns/step"
+              << std::setw(10) << "Checksum" << "\n";
+    for (const RunResult& r : rs) {
+        if (r.threads != rs.front().threads) continue;
+        double ns_per = r.stats.median * 1e6 / static_cast<double>(r.n);
+        std::cout << std::setw(14) << r.n;
+        if (r.chunk) std::cout << std::setw(10) << r.chunk;
+        else std::cout << std::setw(10) << "-";
+        std::cout << std::setw(11) << (*r.variant ? r.variant : "-")
+                  << std::setw(16) << std::setprecision(6) << r.stats.median
+                  << std::setw(16) << r.stats.p99
+                  << std::setw(14) << std::setprecision(3) << ns_per
+                  << std::setw(10) << r.checksum << "\n";
+    }
+    std::cout << "\n";
+}
+
+// Speedup and parallel efficiency against the 1-thread run of the same N.
+static void print_thread_scaling(const Workload& w, const std::vector<RunResult>& rs) {
+    std::cout << "--- Thread Scaling: " << w.name << " ---\n";
+    std::cout << std::right << std::setw(14) << "N" << std::setw(9) << "Threads" << std::setw(16)
+              << "Median (ms)" << std::setw(10) << "Speedup" << std::setw(12) << "Efficiency" << "\n";
+    for (const RunResult& r : rs) {
+        const RunResult* base = nullptr;
+        for (const RunResult& b : rs)
+            if (b.n == r.n && b.threads == 1) base = &b;
+        std::cout << std::setw(14) << r.n << std::setw(9) << r.threads
+                  << std::setw(16) << std::setprecision(6) << r.stats.median;
+        if (base && r.stats.median > 0) {
+            double speedup = base->stats.median / r.stats.median;
+            std::cout << std::setw(10) << std::setprecision(2) << speedup
+                      << std::setw(11) << std::setprecision(1) << 100.0 * speedup / r.threads << "%";
+        } else {
+            std::cout << std::setw(10) << "-" << std::setw(12) << "-";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "\n";
+}
+
+// Each heap's median against the zone run of the same N.
+static void print_baselines(const Workload& w, const std::vector<RunResult>& rs) {
+    std::cout << "--- Baselines: " << w.name << " ---\n";
+    std::cout << std::right << std::setw(14) << "N" << std::setw(12) << "Heap" << std::setw(16) << "Median (ms)"
+              << std::setw(14) << "ns/object" << std::setw(10) << "vs zone" << "\n";
+    const char* zone = baseline::heap_name(baseline::Heap::Zone);
+    for (const RunResult& r : rs) {
+        const RunResult* base = nullptr;
+        for (const RunResult& b : rs)
+            if (b.n == r.n && !std::strcmp(b.variant, zone)) base = &b;
+        std::cout << std::setw(14) << r.n << std::setw(12) << r.variant << std::setw(16) << std::setprecision(6)
+                  << r.stats.median << std::setw(14) << std::setprecision(3)
+                  << r.stats.median * 1e6 / static_cast<double>(r.n);
+        if (base && base->stats.median > 0)
+            std::cout << std::setw(9) << std::setprecision(2) << r.stats.median / base->stats.median << "x";
+        else
+            std::cout << std::setw(10) << "-";
+        std::cout << "\n";
+    }
+    std::cout << "\n";
+}
+
+int main(int argc, char** argv) {
+    ConsoleTap tap_out(std::cout), tap_err(std::cerr);
+    Options opt;
+    if (!parse_args(argc, argv, opt)) return 1;
+
+    sys::pin_to_core_and_boost(0);
+
+    // "local" is the node of the CPU that thread 0 of every pool runs on.
+    int zone_node = opt.zone_node;
+    if (opt.zone_node_local)
+        zone_node = static_cast<int>(sys::topology().node_of(sys::placement(sys::topology(), opt.pin, 1).front()));
+
+    Output out;
+    if (!opt.json_path.empty() && !out.writer.open_json(opt.json_path)) {
+        std::cerr << "could not open --json file: " << opt.json_path << "\n";
+        return 1;
+    }
+    if (!opt.csv_path.empty() && !out.writer.open_csv(opt.csv_path)) {
+        std::cerr << "could not open --csv file: " << opt.csv_path << "\n";
+        return 1;
+    }
+    out.baselines = report::Baselines(opt.baseline, opt.baseline_dir, opt.threshold_pct, opt.alpha);
+    if (out.active()) {
+        out.host = report::host_record();
+        out.host.str("pin", sys::pin_policy_name(opt.pin));
+        if (zone_node >= 0) out.host.num("zone_node", zone_node);
+        else out.host.null("zone_node");
+        out.host.str("zone_pages", sys::page_kind_name(opt.zone_pages)).flag("prefault", opt.prefault);
+        out.host.num("slice_slots", opt.slice_slots).num("slice_us", opt.slice_us);
+        out.host.num("promote_after", opt.promote_after);
+    }
+
+    // Reserved once and shared by every zone workload; only the pages a run
+    // touches are committed, on --zone-node when one is set, unless
+    // --prefault touches all of them here first.
+    std::unique_ptr<vgc::ZoneSet> zones;
+    for (const Workload* w : opt.workloads) {
+        if (!(w->flags & (kZone | kYield)) || zones) continue;
+        zones.reset(new vgc::ZoneSet(opt.zone_mb << 20, opt.zone_pages));
+        if (!zones->ok()) {
+            std::cerr << "could not reserve 3 x " << opt.zone_mb << " MB of "
+                      << sys::page_kind_name(opt.zone_pages) << " pages for the zones\n";
+            if (opt.zone_pages == sys::PageKind::Huge2M || opt.zone_pages == sys::PageKind::Huge1G)
+                std::cerr << "explicit huge pages need a large enough pool (Linux: /proc/sys/vm/nr_hugepages or "
+                             "hugepagesz=1G at boot) or SeLockMemoryPrivilege (Windows); try a smaller --zone-mb\n";
+            return 1;
+        }
+        zones->set_node(zone_node);
+        if (opt.prefault && !zones->prefault(opt.zone_mb << 20)) {
+            std::cerr << "could not pre-fault 3 x " << opt.zone_mb << " MB for the zones\n";
+            return 1;
+        }
+    }
+
+    for (const Workload* w : opt.workloads) {
+        std::vector<std::size_t> sizes = opt.sizes;
+        if (sizes.empty()) sizes.assign(std::begin(w->default_sizes), std::end(w->default_sizes));
+
+        std::vector<unsigned> thread_counts(1, 1);
+        if (w->flags & kParallel)
+            thread_counts = opt.threads.empty() ? std::vector<unsigned>(1, sys::cpu_count()) : opt.threads;
+        std::vector<const simd::LoopKernel*> kernels(1, nullptr);
+        if (w->flags & kKernel)
+            kernels = opt.kernels.empty() ? std::vector<const simd::LoopKernel*>(1, &simd::select_loop_kernel())
+                                          : opt.kernels;
+        std::vector<const engine::KernelEntry*> lambdas(1, nullptr);
+        if (w->flags & kLambda)
+            lambdas = opt.lambdas.empty() ? std::vector<const engine::KernelEntry*>(1, engine::find_kernel("loop_term"))
+                                          : opt.lambdas;
+        std::vector<const vgc::SweepKernel*> sweeps(1, nullptr);
+        if (w->run == run_bitfield_sweep)
+            sweeps = opt.sweep_kernels.empty() ? std::vector<const vgc::SweepKernel*>(1, &vgc::select_sweep_kernel())
+                                               : opt.sweep_kernels;
+
+        std::vector<baseline::Heap> managers(1, baseline::Heap::Zone);
+        if ((w->flags & kHeap) && !opt.managers.empty()) managers = opt.managers;
+
+        std::vector<int> chunks = opt.chunk_sizes;
+        if (chunks.empty() || !(w->flags & kChunked)) chunks.assign(1, 1000);
+        std::unique_ptr<deep::ExplicitStack> frames;
+        if (w->run == run_recursive_explicit) frames.reset(new deep::ExplicitStack);
+        std::unique_ptr<vgc::SweepHeap> heap;
+        std::unique_ptr<vgc::Bitfield> live;
+        if (w->run == run_zone_chunk_batch || w->run == run_zone_chunk_objects) live.reset(new vgc::Bitfield);
+        std::unique_ptr<baseline::GraphTable> graph;
+        if (w->run == run_zone_long_graph) graph.reset(new baseline::GraphTable);
+        if (w->flags & kSweep) heap.reset(new vgc::SweepHeap);
+        std::unique_ptr<vgc::YieldCache> yield;
+        if (w->flags & kYield) yield.reset(new vgc::YieldCache(zones->red));
+        std::unique_ptr<vgc::LayeredHeap> layers;
+        if (w->run == run_gc_layered) {
+            layers.reset(new vgc::LayeredHeap((w->flags & kLayered) != 0));
+            layers->set_slicing(opt.slice_slots, opt.slice_us);
+            if (!layers->ok()) {
+                std::cerr << "could not build the " << w->name << " heap\n";
+                return 1;
+            }
+        }
+#if defined(VGC_HAS_COROUTINES)
+        std::unique_ptr<deep::CoroutineDriver<deep::ZoneFrames>> coro_zone;
+        std::unique_ptr<deep::CoroutineDriver<deep::HeapFrames>> coro_heap;
+        if (w->run == run_recursive_coroutine)
+            coro_zone.reset(new deep::CoroutineDriver<deep::ZoneFrames>(deep::ZoneFrames{zones->red, {}}));
+        if (w->run == run_recursive_coroutine_heap)
+            coro_heap.reset(new deep::CoroutineDriver<deep::HeapFrames>(deep::HeapFrames{}));
+#endif
+        std::unique_ptr<vgc::ConstantSnapshot> snapshot;
+        if (w->run == run_snapshot_rebuild || w->run == run_snapshot_map) {
+            bool keep = !opt.snapshot_path.empty();
+            snapshot.reset(new vgc::ConstantSnapshot(keep ? opt.snapshot_path : "vgc_snapshot.tmp", opt.zone_mb << 20,
+                                                     keep));
+            if (!snapshot->ok()) {
+                std::cerr << "could not reserve " << opt.zone_mb << " MB for the constant zone\n";
+                return 1;
+            }
+        }
+        std::unique_ptr<vgc::GenerationalHeap> generations;
+        std::vector<unsigned> survivals(1, 10);
+        if (w->run == run_gc_generational) {
+            generations.reset(new vgc::GenerationalHeap(opt.promote_after));
+            if (!generations->ok()) {
+                std::cerr << "could not reserve the " << w->name << " zones\n";
+                return 1;
+            }
+            survivals = opt.survival.empty() ? std::vector<unsigned>{1, 10, 50} : opt.survival;
+        }
+
+        std::vector<RunResult> results;
+        for (std::size_t n : sizes) {
+            if (snapshot && !snapshot->prepare(n)) {
+                std::cerr << "could not write the " << n << "-constant snapshot to " << snapshot->path()
+                          << " (--zone-mb too small, or the file not writable)\n";
+                return 1;
+            }
+            for (unsigned t : thread_counts) {
+                std::unique_ptr<sys::WorkerPool> pool;
+                std::unique_ptr<sys::PerThread<short>> partials;
+                std::unique_ptr<sys::ChunkScheduler> sched;
+                std::unique_ptr<vgc::ParallelCollector> collector;
+                std::unique_ptr<vgc::InterpreterSet> interpreters;
+                if (w->flags & kParallel) {
+                    pool.reset(new sys::WorkerPool(t, sys::placement(sys::topology(), opt.pin, t)));
+                    if (w->run == run_loop_partitioned || w->run == run_lambda_partitioned)
+                        partials.reset(new sys::PerThread<short>(pool->size()));
+                    if (w->run == run_recursive_stealing || w->run == run_lambda_stealing)
+                        sched.reset(new sys::ChunkScheduler(*pool));
+                    if (w->run == run_gc_parallel) {
+                        collector.reset(new vgc::ParallelCollector(*pool, zones->green));
+                        if (!collector->ok()) {
+                            std::cerr << "could not reserve the collector bitfields\n";
+                            return 1;
+                        }
+                    }
+                    if (w->run == run_interp_isolated) {
+                        interpreters.reset(new vgc::InterpreterSet(*pool, opt.zone_mb << 20, opt.zone_pages,
+                                                                   opt.zone_node_local));
+                        if (!interpreters->ok()) {
+                            std::cerr << "could not reserve " << t << " x 3 x " << opt.zone_mb
+                                      << " MB for the interpreter zones\n";
+                            return 1;
+                        }
+                    }
+                }
+                for (const simd::LoopKernel* k : kernels) {
+                    for (const vgc::SweepKernel* sk : sweeps) {
+                        for (baseline::Heap m : managers) {
+                            for (int c : chunks) {
+                                for (unsigned s : survivals) {
+                                    for (const engine::KernelEntry* lk : lambdas) {
+                                        Params p;
+                                        p.n = n;
+                                        p.chunk_size = c;
+                                        p.pool = pool.get();
+                                        p.partials = partials.get();
+                                        p.sched = sched.get();
+                                        p.kernel = k;
+                                        p.lambda = lk;
+                                        p.frames = frames.get();
+                                        if (w->flags & kZone) p.zones = zones.get();
+                                        p.heap = heap.get();
+                                        p.gate = opt.gate;
+                                        p.sweep_kernel = sk;
+                                        p.offload = opt.offload;
+                                        p.yield = yield.get();
+                                        p.collector = collector.get();
+                                        p.layers = layers.get();
+                                        p.manager = m;
+                                        p.generations = generations.get();
+                                        p.survival_pct = s;
+                                        p.interpreters = interpreters.get();
+                                        p.live = live.get();
+                                        p.graph = graph.get();
+                                        p.snapshot = snapshot.get();
+#if defined(VGC_HAS_COROUTINES)
+                                        p.coro_zone = coro_zone.get();
+                                        p.coro_heap = coro_heap.get();
+#endif
+                                        results.push_back(run_one(*w, p, opt, out));
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        if (sizes.size() > 1 || kernels.size() > 1 || lambdas.size() > 1 || sweeps.size() > 1 ||
+            managers.size() > 1 || chunks.size() > 1 || survivals.size() > 1)
+            print_scaling(*w, results);
+        if (managers.size() > 1) print_baselines(*w, results);
+        if (thread_counts.size() > 1) print_thread_scaling(*w, results);
+    }
+
+    // 1 is reserved for usage and setup errors. A wrong result (3) outranks
+    // a slower one (2).
+    if (checksum_mismatches)
+        std::cout << "--- Checksums ---\n" << checksum_mismatches << " MISMATCH(ES), see above\n";
+    if (out.baselines.mode() == report::BaselineMode::Check) {
+        const report::Baselines& b = out.baselines;
+        std::cout << std::defaultfloat << "--- Regression Check (" << b.dir() << ", threshold "
+                  << b.threshold_pct() << "%, alpha " << b.alpha() << ") ---\n"
+                  << b.compared() << " runs compared, " << b.missing() << " without a baseline, "
+                  << b.regressions() << " regressed\n";
+        if (checksum_mismatches) return 3;
+        if (b.regressions()) return 2;
+    }
+    if (checksum_mismatches) return 3;
+}
@@ -0,0 +1,37 @@
+// === VGC 2.5 PPE Workload Kernels ===
+// Loop and recursion kernels, formerly duplicated across the 10k..400k programs.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// ============================================================
+// Single-core loop (optimized for small scale)
+// ============================================================
+constexpr short loop_chunk(std::size_t begin, std::size_t end) {
+    short acc = 0;
+    for (std::size_t i = begin; i < end; ++i)
+        acc += static_cast<short>((2 * i + 1) % 32767);  // bounded 2-byte range
+    return acc;
+}
+
+// ============================================================
+// Safe Recursion: Depth 1000. Accumulator pattern. The term is formed in
+// 64 bits: depth * 3 in int overflows for --chunk above (INT_MAX - 1) / 3.
+// ============================================================
+constexpr short recursive_chunk(int depth, int limit, short acc) {
+    if (depth == limit) return acc;
+    return recursive_chunk(depth + 1, limit,
+                           acc + static_cast<short>((static_cast<std::int64_t>(depth) * 3 + 1) % 32767));
+}
+
+inline short recursive_driver(std::size_t total_steps, int chunk_size = 1000) {
+    short acc = 0;
+    std::size_t done = 0;
+    while (done < total_steps) {
+        acc += recursive_chunk(0, chunk_size, 0);
+        done += static_cast<std::size_t>(chunk_size);
+    }
+    return acc;
+}
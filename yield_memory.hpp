@@ -0,0 +1,110 @@
+// === VGC 2.5 PPE Yield Memory (Thread-Local Small-Object Cache) ===
+// Per-size-class magazines in front of a zone, refilled and flushed in batches.
+
+#pragma once
+
+#include "zone.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace vgc {
+    // ============================================================
+    // Yield Memory: one cache per thread, never shared, so alloc() and free()
+    // are a magazine pop/push with no atomics. An empty magazine refills
+    // kBatch blocks from the zone under one lock acquisition; a full one
+    // flushes its kBatch oldest blocks back the same way. Sizes above
+    // kMaxSmall pass through to the zone's locked path.
+    // ============================================================
+    class YieldCache {
+    public:
+        static constexpr std::size_t kMagazine = 64;            // blocks held per size class
+        static constexpr std::size_t kBatch = kMagazine / 2;    // blocks moved per refill / flush
+
+        struct Stats {
+            std::uint64_t allocs = 0;
+            std::uint64_t refills = 0;
+            std::uint64_t flushes = 0;
+            std::uint64_t passthrough = 0;   // large blocks served by the zone
+        };
+
+        explicit YieldCache(Zone& zone) : zone_(zone) {}
+        YieldCache(const YieldCache&) = delete;
+        YieldCache& operator=(const YieldCache&) = delete;
+        ~YieldCache() { flush(); }
+
+        Zone& zone() const { return zone_; }
+
+        void* alloc(std::size_t bytes) {
+            ++stats_.allocs;
+            if (bytes > kMaxSmall) {
+                ++stats_.passthrough;
+                return zone_.alloc_locked(bytes);
+            }
+            std::size_t c = size_class(bytes);
+            Magazine& m = mags_[c];
+            if (m.count == 0 && !refill(c)) return nullptr;
+            return m.blocks[--m.count];
+        }
+
+        // `bytes` must be the size passed to alloc().
+        void free(void* p, std::size_t bytes) {
+            if (!p) return;
+            if (bytes > kMaxSmall) {
+                zone_.free_locked(p, bytes);
+                return;
+            }
+            std::size_t c = size_class(bytes);
+            Magazine& m = mags_[c];
+            if (m.count == kMagazine) flush_oldest(c, kBatch);
+            m.blocks[m.count++] = p;
+        }
+
+        // Returns every cached block to the zone.
+        void flush() {
+            for (std::size_t c = 0; c < kSizeClasses; ++c) flush_oldest(c, mags_[c].count);
+        }
+
+        // Forgets every cached block without returning it; for after the
+        // zone itself has been reset.
+        void discard() {
+            for (Magazine& m : mags_) m.count = 0;
+        }
+
+        std::size_t cached_blocks() const {
+            std::size_t n = 0;
+            for (const Magazine& m : mags_) n += m.count;
+            return n;
+        }
+
+        const Stats& stats() const { return stats_; }
+        void reset_stats() { stats_ = Stats{}; }
+
+    private:
+        struct Magazine {
+            std::size_t count = 0;
+            void* blocks[kMagazine];
+        };
+
+        bool refill(std::size_t c) {
+            ++stats_.refills;
+            mags_[c].count = zone_.refill(c, mags_[c].blocks, kBatch);
+            return mags_[c].count != 0;
+        }
+
+        // Keeps the most recently freed blocks, which are the ones still in cache.
+        void flush_oldest(std::size_t c, std::size_t n) {
+            Magazine& m = mags_[c];
+            if (n == 0) return;
+            ++stats_.flushes;
+            zone_.drain(c, m.blocks, n);
+            m.count -= n;
+            std::memmove(m.blocks, m.blocks + n, m.count * sizeof(void*));
+        }
+
+        Zone& zone_;
+        Magazine mags_[kSizeClasses];
+        Stats stats_;
+    };
+}
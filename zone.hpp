@@ -0,0 +1,333 @@
+// === VGC 2.5 PPE Zone Allocator (Red / Green / Blue Arenas) ===
+// Bump-pointer arenas with size-class free lists, one zone per object lifetime.
+
+#pragma once
+
+#include "parallel.hpp"
+#include "sys.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace vgc {
+    // Red: short-lived temporaries. Green: mixed lifetimes. Blue: long-lived
+    // structures. The zones share one implementation and never share memory.
+    // Passive: the never-collected layer of startup constants (layered.hpp).
+    enum class ZoneId : unsigned char { Red, Green, Blue, Passive };
+
+    inline const char* zone_name(ZoneId z) {
+        switch (z) {
+            case ZoneId::Red:   return "Red";
+            case ZoneId::Green: return "Green";
+            case ZoneId::Blue:  return "Blue";
+            case ZoneId::Passive: return "Passive";
+        }
+        return "?";
+    }
+
+    // Every block starts on a 16-byte slot, so slot_index() is a shift and
+    // a liveness bitfield needs one bit per slot.
+    constexpr std::size_t kSlotBytes = 16;
+    constexpr std::size_t kSizeClasses = 32;                          // 16, 32, ..., 512
+    constexpr std::size_t kMaxSmall = kSlotBytes * kSizeClasses;
+    constexpr std::size_t kCommitStep = std::size_t(1) << 20;         // commit granularity
+
+    constexpr std::size_t round_up(std::size_t v, std::size_t to) { return (v + to - 1) / to * to; }
+    constexpr std::size_t size_class(std::size_t bytes) { return bytes ? (bytes - 1) / kSlotBytes : 0; }
+    constexpr std::size_t class_bytes(std::size_t c) { return (c + 1) * kSlotBytes; }
+    // What alloc() takes out of the zone for a block of `bytes`.
+    constexpr std::size_t block_bytes(std::size_t bytes) {
+        return bytes <= kMaxSmall ? class_bytes(size_class(bytes)) : round_up(bytes, kSlotBytes);
+    }
+
+    // `count` blocks of `bytes` each (as requested), `stride` apart in
+    // address order from `base`: what alloc_batch() hands out.
+    struct BlockSpan {
+        char* base = nullptr;
+        std::size_t stride = 0;
+        std::size_t count = 0;
+        std::size_t bytes = 0;
+
+        explicit operator bool() const { return base != nullptr; }
+        void* operator[](std::size_t i) const { return base + i * stride; }
+        char* end() const { return base + count * stride; }
+    };
+
+    // ============================================================
+    // Zone: one reserved address range, committed lazily as the bump pointer
+    // advances. Freed small blocks go on an intrusive per-class free list and
+    // are reused before the bump pointer moves; large blocks (> kMaxSmall)
+    // are bump-only and come back only with reset(). alloc() returns nullptr
+    // once the reservation is exhausted.
+    //
+    // Pages land wherever they are first touched, unless set_node() binds
+    // the zone's later commits to one NUMA node. A PageKind other than
+    // Normal backs the zone with large pages: THP commits in 2 MB steps and
+    // advises each step; explicit 2 MB / 1 GB pages are committed at
+    // construction and never decommitted. prefault() touches pages ahead of
+    // the timed runs so first-touch faults stay out of them.
+    //
+    // freeze() makes the committed pages read-only and closes the zone to
+    // allocation; any write, free() included, faults until thaw(). Thaw
+    // before reset() or trim().
+    //
+    // alloc_batch() bumps n contiguous blocks at once, past the free lists.
+    // free_batch() of the most recent batch, with nothing allocated after
+    // it, rewinds the bump pointer: O(1) for any n, so a chunk of objects
+    // built and dropped together costs one call each way. Any other batch
+    // goes onto its class's free list as one chained splice.
+    //
+    // alloc()/free() take no lock. Once a zone is shared between threads,
+    // every access goes through the *_locked calls or moves whole batches
+    // with refill()/drain(), each taking the zone's spinlock once per call.
+    // ============================================================
+    class Zone {
+    public:
+        static constexpr bool kBulkFree = true;   // reset() reclaims everything
+
+        Zone(ZoneId id, std::size_t capacity_bytes, sys::PageKind pages = sys::PageKind::Normal)
+            : id_(id), pages_(pages) {
+            std::size_t large = sys::page_size(pages);
+            step_ = large > kCommitStep ? large : kCommitStep;
+            capacity_ = round_up(capacity_bytes ? capacity_bytes : step_, step_);
+            base_ = large ? static_cast<char*>(sys::reserve_pages(capacity_, pages, precommitted_)) : nullptr;
+            if (!base_) capacity_ = 0;
+            top_ = commit_end_ = base_;
+            end_ = base_ + capacity_;
+            if (precommitted_) commit_end_ = end_;
+            reset();
+        }
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+        ~Zone() {
+            if (base_) sys::release_pages(base_, capacity_);
+        }
+
+        bool ok() const { return base_ != nullptr; }
+        ZoneId id() const { return id_; }
+        const char* name() const { return zone_name(id_); }
+
+        void* alloc(std::size_t bytes) {
+            void* p;
+            if (bytes <= kMaxSmall) {
+                std::size_t c = size_class(bytes);
+                if (FreeBlock* b = free_[c]) {
+                    free_[c] = b->next;
+                    p = b;
+                } else if (!(p = bump(class_bytes(c)))) {
+                    return nullptr;
+                }
+            } else if (!(p = bump(round_up(bytes, kSlotBytes)))) {
+                return nullptr;
+            }
+            ++allocs_;
+            live_bytes_ += bytes;
+            if (live_bytes_ > peak_live_bytes_) peak_live_bytes_ = live_bytes_;
+            return p;
+        }
+
+        // `bytes` must be the size passed to alloc().
+        void free(void* p, std::size_t bytes) {
+            if (!p) return;
+            if (bytes <= kMaxSmall) {
+                FreeBlock* b = static_cast<FreeBlock*>(p);
+                std::size_t c = size_class(bytes);
+                b->next = free_[c];
+                free_[c] = b;
+            }
+            ++frees_;
+            live_bytes_ -= bytes;
+        }
+
+        // An empty span if the reservation cannot take all `n`.
+        BlockSpan alloc_batch(std::size_t n, std::size_t bytes) {
+            std::size_t stride = block_bytes(bytes);
+            if (!n || n > capacity_ / stride) return BlockSpan{};
+            char* p = static_cast<char*>(bump(stride * n));
+            if (!p) return BlockSpan{};
+            allocs_ += n;
+            live_bytes_ += n * bytes;
+            if (live_bytes_ > peak_live_bytes_) peak_live_bytes_ = live_bytes_;
+            return BlockSpan{p, stride, n, bytes};
+        }
+
+        void free_batch(const BlockSpan& s) {
+            if (!s) return;
+            frees_ += s.count;
+            live_bytes_ -= s.count * s.bytes;
+            if (s.end() == top_) {
+                top_ = s.base;
+                return;
+            }
+            if (s.bytes > kMaxSmall) return;   // bump-only, back with reset()
+            std::size_t c = size_class(s.bytes);
+            for (std::size_t k = 0; k + 1 < s.count; ++k)
+                static_cast<FreeBlock*>(s[k])->next = static_cast<FreeBlock*>(s[k + 1]);
+            static_cast<FreeBlock*>(s[s.count - 1])->next = free_[c];
+            free_[c] = static_cast<FreeBlock*>(s[0]);
+        }
+
+        // Up to `n` blocks of size class `c` into out[]; returns how many.
+        std::size_t refill(std::size_t c, void** out, std::size_t n) {
+            std::lock_guard<sys::SpinLock> hold(lock_);
+            std::size_t k = 0;
+            for (; k < n; ++k)
+                if (!(out[k] = alloc(class_bytes(c)))) break;
+            return k;
+        }
+
+        void drain(std::size_t c, void* const* in, std::size_t n) {
+            std::lock_guard<sys::SpinLock> hold(lock_);
+            for (std::size_t k = 0; k < n; ++k) free(in[k], class_bytes(c));
+        }
+
+        void* alloc_locked(std::size_t bytes) {
+            std::lock_guard<sys::SpinLock> hold(lock_);
+            return alloc(bytes);
+        }
+
+        void free_locked(void* p, std::size_t bytes) {
+            std::lock_guard<sys::SpinLock> hold(lock_);
+            free(p, bytes);
+        }
+
+        // O(1) regardless of how many objects are live: rewinds the bump
+        // pointer and drops the free lists. Committed pages stay committed.
+        void reset() {
+            top_ = base_;
+            for (FreeBlock*& f : free_) f = nullptr;
+            allocs_ = frees_ = 0;
+            live_bytes_ = peak_live_bytes_ = 0;
+        }
+
+        // Commits from now on go to `node` (-1: the OS default, first touch).
+        // Pages committed earlier stay where they are; trim() first to move
+        // the whole zone.
+        void set_node(int node) { node_ = node; }
+        int node() const { return node_; }
+
+        // The bump pointer's end moves down to top_ and the free lists are
+        // dropped, so alloc() returns nullptr without a check on its path.
+        bool freeze() {
+            if (frozen_) return true;
+            if (commit_end_ != base_ && !sys::protect_pages(base_, committed_bytes(), false)) return false;
+            end_ = top_;
+            for (FreeBlock*& f : free_) f = nullptr;
+            frozen_ = true;
+            return true;
+        }
+        void thaw() {
+            if (!frozen_) return;
+            if (commit_end_ != base_) sys::protect_pages(base_, committed_bytes(), true);
+            end_ = base_ + capacity_;
+            frozen_ = false;
+        }
+        bool frozen() const { return frozen_; }
+
+        // Returns the committed pages to the OS; the reservation stays.
+        // Explicit large pages stay committed.
+        void trim() {
+            reset();
+            if (precommitted_) return;
+            if (commit_end_ != base_) sys::decommit_pages(base_, static_cast<std::size_t>(commit_end_ - base_));
+            commit_end_ = base_;
+        }
+
+        // Commits the first `bytes` (capped at the capacity) and writes one
+        // byte into every page of it above the bump pointer, so live blocks
+        // keep their contents. Returns false if the commit fails.
+        bool prefault(std::size_t bytes) {
+            char* want = base_ + (bytes < capacity_ ? bytes : capacity_);
+            if (want > commit_end_ && !grow(want)) return false;
+            const std::size_t page = sys::page_size();
+            for (char* p = top_; p < want; p += page - static_cast<std::size_t>(p - base_) % page)
+                *static_cast<volatile char*>(p) = 0;
+            return true;
+        }
+
+        bool owns(const void* p) const {
+            const char* c = static_cast<const char*>(p);
+            return c >= base_ && c < top_;
+        }
+        std::size_t slot_index(const void* p) const {
+            return static_cast<std::size_t>(static_cast<const char*>(p) - base_) / kSlotBytes;
+        }
+        void* slot_address(std::size_t slot) const { return base_ + slot * kSlotBytes; }
+        std::size_t slot_count() const { return used_bytes() / kSlotBytes; }
+
+        // Counters below cover the time since the last reset().
+        std::size_t used_bytes() const { return static_cast<std::size_t>(top_ - base_); }
+        std::size_t committed_bytes() const { return static_cast<std::size_t>(commit_end_ - base_); }
+        std::size_t capacity_bytes() const { return capacity_; }
+        // Committed bytes with physical pages behind them right now.
+        std::size_t resident_bytes() const { return sys::resident_bytes(base_, committed_bytes()); }
+        sys::PageKind pages() const { return pages_; }
+        std::size_t commit_step() const { return step_; }
+        bool precommitted() const { return precommitted_; }
+        std::size_t live_bytes() const { return live_bytes_; }            // requested, not rounded
+        std::size_t peak_live_bytes() const { return peak_live_bytes_; }
+        std::uint64_t allocs() const { return allocs_; }
+        std::uint64_t frees() const { return frees_; }
+
+    private:
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        void* bump(std::size_t rounded) {
+            if (rounded > static_cast<std::size_t>(end_ - top_)) return nullptr;
+            char* next = top_ + rounded;
+            if (next > commit_end_ && !grow(next)) return nullptr;
+            char* p = top_;
+            top_ = next;
+            return p;
+        }
+
+        bool grow(const char* need) {
+            char* want = base_ + round_up(static_cast<std::size_t>(need - base_), step_);
+            std::size_t bytes = static_cast<std::size_t>(want - commit_end_);
+            bool ok = node_ < 0 ? sys::commit_pages(commit_end_, bytes)
+                                : sys::commit_pages_on_node(commit_end_, bytes, static_cast<unsigned>(node_));
+            if (!ok) return false;
+            sys::advise_pages(commit_end_, bytes, pages_);
+            commit_end_ = want;
+            return true;
+        }
+
+        ZoneId id_;
+        char* base_ = nullptr;
+        char* top_ = nullptr;
+        char* commit_end_ = nullptr;
+        char* end_ = nullptr;
+        std::size_t capacity_ = 0;
+        std::size_t step_ = kCommitStep;
+        sys::PageKind pages_;
+        bool precommitted_ = false;
+        bool frozen_ = false;
+        int node_ = -1;
+        FreeBlock* free_[kSizeClasses] = {};
+        std::uint64_t allocs_ = 0, frees_ = 0;
+        std::size_t live_bytes_ = 0, peak_live_bytes_ = 0;
+        sys::SpinLock lock_;
+    };
+
+    struct ZoneSet {
+        explicit ZoneSet(std::size_t bytes_per_zone, sys::PageKind pages = sys::PageKind::Normal)
+            : red(ZoneId::Red, bytes_per_zone, pages), green(ZoneId::Green, bytes_per_zone, pages),
+              blue(ZoneId::Blue, bytes_per_zone, pages) {}
+
+        bool ok() const { return red.ok() && green.ok() && blue.ok(); }
+        bool prefault(std::size_t bytes_per_zone) {
+            return red.prefault(bytes_per_zone) && green.prefault(bytes_per_zone) && blue.prefault(bytes_per_zone);
+        }
+        void set_node(int node) {
+            red.set_node(node);
+            green.set_node(node);
+            blue.set_node(node);
+        }
+        Zone& operator[](ZoneId z) { return z == ZoneId::Red ? red : z == ZoneId::Green ? green : blue; }
+
+        Zone red, green, blue;
+    };
+}
@@ -0,0 +1,288 @@
+// === VGC 2.5 PPE Zone Workloads (Short-Lived, Mixed, Long-Lived Graph) ===
+// Allocation-heavy drivers for the R/G/B zones, checksummed like loop_chunk.
+
+#pragma once
+
+#include "bitfield.hpp"
+#include "measure.hpp"
+#include "yield_memory.hpp"
+#include "zone.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vgc {
+    // Every workload allocates N objects, stores loop_chunk's term
+    // (2i + 1) % 32767 in object i and reads each object back exactly once,
+    // so the checksum equals loop_chunk(0, N) whatever the allocation order.
+    inline short term(std::size_t i) { return static_cast<short>((i * 2 + 1) % 32767); }
+
+    struct Object {
+        std::uint32_t bytes;   // size passed to alloc(), needed by free()
+        short value;
+    };
+
+    // Deterministic sizes: 16..`max_bytes` in 16-byte steps.
+    inline std::size_t object_bytes(std::uint64_t& rng, std::size_t max_bytes) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        return kSlotBytes * (1 + static_cast<std::size_t>(rng % (max_bytes / kSlotBytes)));
+    }
+
+    // The drivers below take any heap with alloc(bytes), free(p, bytes),
+    // reset() and kBulkFree (reset() reclaims every object, so long-lived
+    // ones are never freed one by one): a Zone, or baseline::MallocHeap.
+    template <class Heap>
+    inline Object* make_object(Heap& z, std::size_t bytes, std::size_t i) {
+        Object* o = static_cast<Object*>(z.alloc(bytes));
+        if (!o) return nullptr;
+        o->bytes = static_cast<std::uint32_t>(bytes);
+        o->value = term(i);
+        return o;
+    }
+
+    // ============================================================
+    // Small, short-lived (Red): batches of 16..64-byte temporaries, each
+    // read and freed before the next batch, so after the first batch every
+    // allocation is a free-list hit.
+    // ============================================================
+    template <class Heap>
+    inline short small_churn(Heap& z, std::size_t n) {
+        constexpr std::size_t kBatch = 256;
+        Object* batch[kBatch];
+        z.reset();
+        short acc = 0;
+        std::size_t i = 0;
+        while (i < n) {
+            std::size_t k = 0;
+            for (; k < kBatch && i < n; ++k, ++i) {
+                batch[k] = make_object(z, kSlotBytes * (1 + (i & 3)), i);
+                if (!batch[k]) return acc;
+            }
+            for (std::size_t j = 0; j < k; ++j) {
+                acc += batch[j]->value;
+                z.free(batch[j], batch[j]->bytes);
+            }
+        }
+        return acc;
+    }
+
+    // ============================================================
+    // Mixed lifetimes (Green): every 8th object lives in a 4096-entry ring,
+    // the rest in a 64-entry ring; placing an object evicts (reads and
+    // frees) the ring's previous occupant. Sizes are pseudo-random up to
+    // 256 bytes, so the free lists fragment across classes.
+    // ============================================================
+    template <class Heap>
+    inline short mixed_lifetime(Heap& z, std::size_t n) {
+        constexpr std::size_t kShort = 64, kLong = 4096;
+        Object* short_ring[kShort] = {};
+        Object* long_ring[kLong] = {};
+        z.reset();
+
+        short acc = 0;
+        std::uint64_t rng = 0x9E3779B97F4A7C15ull;
+        std::size_t s = 0, l = 0;
+        auto place = [&](Object*& slot, Object* o) {
+            if (slot) {
+                acc += slot->value;
+                z.free(slot, slot->bytes);
+            }
+            slot = o;
+        };
+        for (std::size_t i = 0; i < n; ++i) {
+            Object* o = make_object(z, object_bytes(rng, 256), i);
+            if (!o) return acc;
+            if (i % 8 == 0) place(long_ring[l++ % kLong], o);
+            else place(short_ring[s++ % kShort], o);
+        }
+        for (Object*& o : short_ring) place(o, nullptr);
+        for (Object*& o : long_ring) place(o, nullptr);
+        return acc;
+    }
+
+    // ============================================================
+    // Long-lived graph (Blue): N nodes, none freed, each linked to its
+    // predecessor and to a pseudo-random earlier node, uniform over all of
+    // them. The traversal walks the predecessor chain for the checksum and
+    // chases the random links alongside, so the pass pays for
+    // pointer-chasing through the zone. A zone drops the whole graph with
+    // its next reset().
+    // ============================================================
+    struct Node {
+        Node* prev;
+        Node* link;
+        short value;
+    };
+
+    // How many nodes back from node i (i > 0) its random link goes: 1..i.
+    inline std::size_t link_back(std::uint64_t& rng, std::size_t i) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        return 1 + static_cast<std::size_t>(rng % i);
+    }
+
+    inline short long_graph(Zone& z, std::size_t n) {
+        constexpr std::size_t kNodeSlots = class_bytes(size_class(sizeof(Node))) / kSlotBytes;
+        z.reset();
+        Node* last = nullptr;
+        std::uint64_t rng = 0xD1B54A32D192ED03ull;
+        for (std::size_t i = 0; i < n; ++i) {
+            Node* node = static_cast<Node*>(z.alloc(sizeof(Node)));
+            if (!node) break;
+            // Nothing is freed, so node j sits at slot j * kNodeSlots.
+            std::size_t back = i ? link_back(rng, i) : 0;
+            node->prev = last;
+            node->link = static_cast<Node*>(z.slot_address(z.slot_index(node) - back * kNodeSlots));
+            node->value = term(i);
+            last = node;
+        }
+
+        short acc = 0;
+        std::uintptr_t chase = 0;
+        for (const Node* node = last; node; node = node->prev) {
+            acc += node->value;
+            chase ^= reinterpret_cast<std::uintptr_t>(node->link->link);
+        }
+        sys::do_not_optimize(chase);
+        return acc;
+    }
+
+    // The same graph on a heap whose addresses cannot be computed: node i
+    // is looked up in `nodes`, a table of at least N entries the caller
+    // sizes outside the timed region. Frees every node unless kBulkFree.
+    template <class Heap>
+    inline short long_graph(Heap& h, std::size_t n, Node** nodes) {
+        h.reset();
+        Node* last = nullptr;
+        std::uint64_t rng = 0xD1B54A32D192ED03ull;
+        for (std::size_t i = 0; i < n; ++i) {
+            Node* node = static_cast<Node*>(h.alloc(sizeof(Node)));
+            if (!node) break;
+            node->prev = last;
+            node->link = i ? nodes[i - link_back(rng, i)] : node;
+            node->value = term(i);
+            nodes[i] = last = node;
+        }
+
+        short acc = 0;
+        std::uintptr_t chase = 0;
+        for (const Node* node = last; node; node = node->prev) {
+            acc += node->value;
+            chase ^= reinterpret_cast<std::uintptr_t>(node->link->link);
+        }
+        sys::do_not_optimize(chase);
+        if (!Heap::kBulkFree) {
+            for (Node* node = last; node;) {
+                Node* prev = node->prev;
+                h.free(node, sizeof(Node));
+                node = prev;
+            }
+        }
+        return acc;
+    }
+
+    // ============================================================
+    // Hot loop with temporaries: loop_chunk's body, except each term goes
+    // through a 16..64-byte temporary that lives for 8 iterations (a request
+    // handler's scratch objects). `Alloc` is a YieldCache, or a Zone shared
+    // under its lock which is what every temporary costs without one.
+    // ============================================================
+    struct LockedZone {
+        Zone& zone;
+        void* alloc(std::size_t bytes) { return zone.alloc_locked(bytes); }
+        void free(void* p, std::size_t bytes) { zone.free_locked(p, bytes); }
+    };
+
+    template <class Alloc>
+    inline short loop_with_temporaries(Alloc& a, std::size_t n) {
+        constexpr std::size_t kLive = 8;
+        Object* live[kLive] = {};
+        short acc = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            Object*& slot = live[i % kLive];
+            if (slot) {
+                acc += slot->value;
+                a.free(slot, slot->bytes);
+            }
+            std::size_t bytes = kSlotBytes * (1 + (i & 3));
+            slot = static_cast<Object*>(a.alloc(bytes));
+            if (!slot) return acc;
+            slot->bytes = static_cast<std::uint32_t>(bytes);
+            slot->value = term(i);
+        }
+        for (Object*& o : live) {
+            if (!o) continue;
+            acc += o->value;
+            a.free(o, o->bytes);
+            o = nullptr;
+        }
+        return acc;
+    }
+
+    // ============================================================
+    // Chunked parse nodes: recursive_driver's chunk structure over a zone,
+    // as a batch parser builds and drops a message's nodes. Each chunk of
+    // up to `chunk` steps builds a list of 32-byte nodes, checkpoints each
+    // in `live`, walks it for the checksum and releases the whole chunk:
+    //
+    //   Batched   one alloc_batch(), then one clear_range() and one
+    //             free_batch() that rewinds the bump pointer
+    //   otherwise an alloc(), and later a clear() and a free(), per node
+    //
+    // Node i stores loop_chunk's term, so the checksum is loop_chunk(0, N).
+    // `live` grows on the first call to the slots of one chunk.
+    // ============================================================
+    struct ParseNode {
+        ParseNode* next;
+        ParseNode* parent;
+        std::uint32_t kind;
+        short value;
+    };
+
+    template <bool Batched>
+    inline short chunk_nodes(Zone& z, Bitfield& live, std::size_t n, int chunk_size) {
+        const std::size_t chunk = static_cast<std::size_t>(chunk_size);
+        z.reset();
+        std::size_t need = chunk * block_bytes(sizeof(ParseNode)) / kSlotBytes;
+        if (live.slots() < need) live.resize(need);
+
+        short acc = 0;
+        std::uintptr_t chase = 0;
+        for (std::size_t done = 0; done < n; done += chunk) {
+            std::size_t k = n - done < chunk ? n - done : chunk;
+            BlockSpan span;
+            if (Batched && !(span = z.alloc_batch(k, sizeof(ParseNode)))) break;
+            ParseNode* head = nullptr;
+            for (std::size_t j = 0; j < k; ++j) {
+                ParseNode* node = static_cast<ParseNode*>(Batched ? span[j] : z.alloc(sizeof(ParseNode)));
+                if (!node) return acc;
+                node->next = head;
+                node->parent = !head ? node : (j & 1) ? head : head->parent;
+                node->kind = static_cast<std::uint32_t>(j & 7);
+                node->value = term(done + j);
+                live.mark(z.slot_index(node));
+                head = node;
+            }
+            for (const ParseNode* node = head; node; node = node->next) {
+                acc += node->value;
+                chase ^= reinterpret_cast<std::uintptr_t>(node->parent);
+            }
+            if (Batched) {
+                live.clear_range(z.slot_index(span.base), z.slot_index(span.end()));
+                z.free_batch(span);
+            } else {
+                for (ParseNode* node = head; node;) {
+                    ParseNode* next = node->next;
+                    live.clear(z.slot_index(node));
+                    z.free(node, sizeof(ParseNode));
+                    node = next;
+                }
+            }
+        }
+        sys::do_not_optimize(chase);
+        return acc;
+    }
+}